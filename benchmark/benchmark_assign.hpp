@@ -119,6 +119,37 @@ namespace xt
             out << "index assign   : " << index_assign.count() << "ms" << std::endl;
             out << std::endl;
         }
+
+        inline double bandwidth(std::size_t size, duration_type d)
+        {
+            // The benchmarked expressions read two arrays and write one
+            return 3. * double(size * sizeof(double)) / (d.count() * 1.e6);
+        }
+
+        template <class OS>
+        inline void benchmark_streaming(OS& out)
+        {
+            std::size_t count = 5;
+            std::size_t size0 = 4096, size1 = 4096;
+            xtensor<double, 2> lhs, rhs, res;
+            init_xtensor_benchmark(lhs, rhs, res, size0, size1);
+
+            duration_type c_loop_assign = benchmark_c_loop(lhs, rhs, res, count);
+            duration_type xtensor_assign = benchmark_xtensor(lhs, rhs, res, count);
+            std::size_t size = size0 * size1;
+
+            out << "******************************" << std::endl;
+            out << "* STREAMING ASSIGN BENCHMARK *" << std::endl;
+            out << "******************************" << std::endl;
+
+            out << "array size     : " << size * sizeof(double) / (1024 * 1024) << "MB" << std::endl;
+            out << "threshold      : " << XTENSOR_STREAMING_THRESHOLD / (1024 * 1024) << "MB" << std::endl;
+            out << "c loop assign  : " << c_loop_assign.count() << "ms ("
+                << bandwidth(size, c_loop_assign) << "GB/s)" << std::endl;
+            out << "xtensor assign : " << xtensor_assign.count() << "ms ("
+                << bandwidth(size, xtensor_assign) << "GB/s)" << std::endl;
+            out << std::endl;
+        }
     }
 }
 
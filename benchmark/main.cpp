@@ -66,6 +66,7 @@ int main(int argc, char* argv[])
                 if (sarg == "assign")
                 {
                     xt::assign::benchmark(std::cout);
+                    xt::assign::benchmark_streaming(std::cout);
                 }
                 else if (sarg == "container")
                 {
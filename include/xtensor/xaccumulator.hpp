@@ -0,0 +1,767 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XACCUMULATOR_HPP
+#define XACCUMULATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xarray.hpp"
+#include "xexpression.hpp"
+#include "xiterable.hpp"
+#include "xmath.hpp"
+#include "xparallel.hpp"
+#include "xreducer.hpp"
+#include "xutils.hpp"
+
+namespace xt
+{
+
+    /**************
+     * accumulate *
+     **************/
+
+    template <class F, class E>
+    auto accumulate(F&& f, E&& e, std::size_t axis);
+
+    /****************
+     * xaccumulator *
+     ****************/
+
+    template <class F, class CT>
+    class xaccumulator;
+
+    template <class F, class CT>
+    class xaccumulator_stepper;
+
+    template <class F, class CT>
+    struct xiterable_inner_types<xaccumulator<F, CT>>
+    {
+        using xexpression_type = std::decay_t<CT>;
+        using inner_shape_type = typename xexpression_type::shape_type;
+        using const_stepper = xaccumulator_stepper<F, CT>;
+        using stepper = const_stepper;
+    };
+
+    /**
+     * @class xaccumulator
+     * @brief Cumulative application of a function along an axis.
+     *
+     * The xaccumulator class implements an \ref xexpression whose element
+     * at position i along the accumulation axis is the result of folding
+     * the elements 0 to i of the underlying expression along this axis with
+     * the accumulating function, which must be associative.
+     *
+     * Assigning an xaccumulator computes all the results in a single pass,
+     * directly in the storage of the assigned container when possible, so
+     * that a preallocated output can be filled with \ref noalias. When the
+     * expression is iterated, e.g. as an operand of an \ref xfunction, it
+     * is evaluated once into a buffer shared by the steppers of the traversal.
+     *
+     * @tparam F the accumulating function type
+     * @tparam CT the closure type of the \ref xexpression to accumulate
+     *
+     * @sa accumulate, cumsum, cumprod, cummin, cummax
+     */
+    template <class F, class CT>
+    class xaccumulator : public xexpression<xaccumulator<F, CT>>,
+                         public xconst_iterable<xaccumulator<F, CT>>
+    {
+    public:
+
+        using self_type = xaccumulator<F, CT>;
+        using functor_type = std::decay_t<F>;
+        using xexpression_type = std::decay_t<CT>;
+
+        using value_type = typename xexpression_type::value_type;
+        using reference = value_type;
+        using const_reference = value_type;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        using size_type = typename xexpression_type::size_type;
+        using difference_type = typename xexpression_type::difference_type;
+
+        using iterable_base = xconst_iterable<self_type>;
+        using inner_shape_type = typename iterable_base::inner_shape_type;
+        using shape_type = inner_shape_type;
+
+        using stepper = typename iterable_base::stepper;
+        using const_stepper = typename iterable_base::const_stepper;
+
+        static constexpr layout_type static_layout = layout_type::dynamic;
+        static constexpr bool contiguous_layout = false;
+
+        template <class Func, class CTA>
+        xaccumulator(Func&& func, CTA&& e, size_type axis);
+
+        size_type size() const noexcept;
+        size_type dimension() const noexcept;
+        const inner_shape_type& shape() const noexcept;
+        layout_type layout() const noexcept;
+        size_type axis() const noexcept;
+
+        template <class... Args>
+        const_reference operator()(Args... args) const;
+        const_reference operator[](const xindex& index) const;
+        const_reference operator[](size_type i) const;
+
+        template <class It>
+        const_reference element(It first, It last) const;
+
+        template <class S>
+        bool broadcast_shape(S& shape) const;
+
+        template <class S>
+        bool is_trivial_broadcast(const S& strides) const noexcept;
+
+        template <class Func>
+        bool visit_memory(Func&& f) const;
+
+        template <class S>
+        const_stepper stepper_begin(const S& shape) const;
+        template <class S>
+        const_stepper stepper_end(const S& shape, layout_type l) const;
+
+        template <class E>
+        void assign_to(xexpression<E>& e) const;
+
+    private:
+
+        using cache_type = xarray<value_type>;
+
+        std::shared_ptr<const cache_type> cache() const;
+
+        CT m_e;
+        functor_type m_f;
+        size_type m_axis;
+        // Values of the accumulator shared by the steppers of a traversal,
+        // freed when the last of them is destroyed.
+        mutable std::weak_ptr<const cache_type> m_cache;
+    };
+
+    /************************
+     * xaccumulator_stepper *
+     ************************/
+
+    template <class F, class CT>
+    class xaccumulator_stepper
+    {
+    public:
+
+        using self_type = xaccumulator_stepper<F, CT>;
+        using xaccumulator_type = xaccumulator<F, CT>;
+
+        using value_type = typename xaccumulator_type::value_type;
+        using reference = typename xaccumulator_type::const_reference;
+        using pointer = typename xaccumulator_type::const_pointer;
+        using size_type = typename xaccumulator_type::size_type;
+        using difference_type = typename xaccumulator_type::difference_type;
+
+        using cache_type = xarray<value_type>;
+        using cache_stepper = typename cache_type::const_stepper;
+
+        xaccumulator_stepper(std::shared_ptr<const cache_type> cache, cache_stepper st);
+
+        reference operator*() const;
+
+        void step(size_type dim, size_type n = 1);
+        void step_back(size_type dim, size_type n = 1);
+        void reset(size_type dim);
+        void reset_back(size_type dim);
+
+        void to_begin();
+        void to_end(layout_type l);
+
+        bool equal(const self_type& rhs) const;
+
+    private:
+
+        std::shared_ptr<const cache_type> m_cache;
+        cache_stepper m_stepper;
+    };
+
+    template <class F, class CT>
+    bool operator==(const xaccumulator_stepper<F, CT>& lhs,
+                    const xaccumulator_stepper<F, CT>& rhs);
+
+    template <class F, class CT>
+    bool operator!=(const xaccumulator_stepper<F, CT>& lhs,
+                    const xaccumulator_stepper<F, CT>& rhs);
+
+    /**************************
+     * accumulating functions *
+     **************************/
+
+    template <class E>
+    auto cumsum(E&& e, std::size_t axis);
+
+    template <class E>
+    auto cumprod(E&& e, std::size_t axis);
+
+    template <class E>
+    auto cummin(E&& e, std::size_t axis);
+
+    template <class E>
+    auto cummax(E&& e, std::size_t axis);
+
+    /*****************************
+     * accumulate implementation *
+     *****************************/
+
+    /**
+     * @brief Returns an \ref xexpression applying the specified accumulating
+     * function to an expression along the given axis.
+     *
+     * @param f the accumulating function, which must be associative.
+     * @param e the \ref xexpression to accumulate.
+     * @param axis the axis along which the function is accumulated.
+     *
+     * The returned expression either hold a const reference to \p e or a copy
+     * depending on whether \p e is an lvalue or an rvalue.
+     */
+    template <class F, class E>
+    inline auto accumulate(F&& f, E&& e, std::size_t axis)
+    {
+        using accumulator_type = xaccumulator<F, const_xclosure_t<E>>;
+        return accumulator_type(std::forward<F>(f), std::forward<E>(e), axis);
+    }
+
+    namespace detail
+    {
+        // Accumulates the slice [first, last) of a row stored contiguously.
+        template <class F, class T>
+        inline void scan_row(const F& f, T* p, std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first + 1; i < last; ++i)
+            {
+                p[i] = f(p[i - 1], p[i]);
+            }
+        }
+
+        // Two-pass parallel scan of a long contiguous row: each chunk is
+        // accumulated independently, then the total of the chunks preceding
+        // it is folded into its elements. Deterministic reductions use the
+        // serial scan, whose result does not depend on the number of threads.
+        template <class F, class T>
+        inline void scan_long_row(const F& f, T* p, std::size_t n)
+        {
+            std::size_t nb_chunks = deterministic_reductions() ? 1 : parallel_chunk_count(n, XTENSOR_PARALLEL_GRAIN_SIZE);
+            if (nb_chunks <= 1)
+            {
+                scan_row(f, p, 0, n);
+                return;
+            }
+            parallel_for_each_chunk(nb_chunks, [&f, p, n, nb_chunks](std::size_t k) {
+                scan_row(f, p, n * k / nb_chunks, n * (k + 1) / nb_chunks);
+            });
+            std::vector<T> carry(nb_chunks);
+            carry[1] = p[n / nb_chunks - 1];
+            for (std::size_t k = 2; k < nb_chunks; ++k)
+            {
+                carry[k] = f(carry[k - 1], p[n * k / nb_chunks - 1]);
+            }
+            parallel_for_each_chunk(nb_chunks - 1, [&f, &carry, p, n, nb_chunks](std::size_t c) {
+                std::size_t k = c + 1;
+                for (std::size_t i = n * k / nb_chunks; i < n * (k + 1) / nb_chunks; ++i)
+                {
+                    p[i] = f(carry[k], p[i]);
+                }
+            });
+        }
+
+        // Accumulates the columns [first, last) of a block of n rows of
+        // inner elements stored contiguously, one row after the other, so
+        // that the innermost loop reads and writes consecutive elements.
+        template <class F, class T>
+        inline void scan_block(const F& f, T* p, std::size_t n, std::size_t inner, std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                const T* prev = p + (i - 1) * inner;
+                T* cur = p + i * inner;
+                for (std::size_t j = first; j < last; ++j)
+                {
+                    cur[j] = f(prev[j], cur[j]);
+                }
+            }
+        }
+
+        // Accumulates in place the row-major buffer p of the given shape
+        // along axis.
+        template <class F, class T, class S>
+        inline void scan_in_place(const F& f, T* p, const S& shape, std::size_t axis)
+        {
+            std::size_t n = shape[axis];
+            std::size_t outer = std::accumulate(shape.cbegin(), shape.cbegin() + std::ptrdiff_t(axis), std::size_t(1), std::multiplies<std::size_t>());
+            std::size_t inner = std::accumulate(shape.cbegin() + std::ptrdiff_t(axis) + 1, shape.cend(), std::size_t(1), std::multiplies<std::size_t>());
+            std::size_t block_size = n * inner;
+            if (n <= 1 || block_size == 0 || outer == 0)
+            {
+                return;
+            }
+            if (outer >= parallel_chunk_count(outer * block_size, XTENSOR_PARALLEL_GRAIN_SIZE))
+            {
+                std::size_t grain = std::max(XTENSOR_PARALLEL_GRAIN_SIZE / block_size, std::size_t(1));
+                parallel_for(outer, grain, [&f, p, n, inner, block_size](std::size_t first, std::size_t last) {
+                    for (std::size_t o = first; o < last; ++o)
+                    {
+                        scan_block(f, p + o * block_size, n, inner, 0, inner);
+                    }
+                });
+            }
+            else if (inner == 1)
+            {
+                for (std::size_t o = 0; o < outer; ++o)
+                {
+                    scan_long_row(f, p + o * n, n);
+                }
+            }
+            else
+            {
+                std::size_t grain = std::max(XTENSOR_PARALLEL_GRAIN_SIZE / n, std::size_t(1));
+                for (std::size_t o = 0; o < outer; ++o)
+                {
+                    T* block = p + o * block_size;
+                    parallel_for(inner, grain, [&f, block, n, inner](std::size_t first, std::size_t last) {
+                        scan_block(f, block, n, inner, first, last);
+                    });
+                }
+            }
+        }
+    }
+
+    /*******************************
+     * xaccumulator implementation *
+     *******************************/
+
+    /**
+     * @name Constructor
+     */
+    //@{
+    /**
+     * Constructs an xaccumulator expression applying the specified
+     * function to the given expression along the given axis.
+     *
+     * @param func the function to apply
+     * @param e the expression to accumulate
+     * @param axis the axis along which the function is accumulated
+     */
+    template <class F, class CT>
+    template <class Func, class CTA>
+    inline xaccumulator<F, CT>::xaccumulator(Func&& func, CTA&& e, size_type axis)
+        : m_e(std::forward<CTA>(e)), m_f(std::forward<Func>(func)), m_axis(axis)
+    {
+        if (m_axis >= m_e.dimension())
+        {
+            throw std::out_of_range("Accumulation axis out of bounds");
+        }
+    }
+    //@}
+
+    /**
+     * @name Size and shape
+     */
+    //@{
+    /**
+     * Returns the size of the expression.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::size() const noexcept -> size_type
+    {
+        return m_e.size();
+    }
+
+    /**
+     * Returns the number of dimensions of the expression.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::dimension() const noexcept -> size_type
+    {
+        return m_e.dimension();
+    }
+
+    /**
+     * Returns the shape of the expression.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::shape() const noexcept -> const inner_shape_type&
+    {
+        return m_e.shape();
+    }
+
+    /**
+     * Returns the layout of the expression.
+     */
+    template <class F, class CT>
+    inline layout_type xaccumulator<F, CT>::layout() const noexcept
+    {
+        return static_layout;
+    }
+
+    /**
+     * Returns the axis along which the function is accumulated.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::axis() const noexcept -> size_type
+    {
+        return m_axis;
+    }
+    //@}
+
+    /**
+     * @name Data
+     */
+    //@{
+    /**
+     * Returns the element at the specified position in the accumulator. It
+     * is computed from the elements preceding it along the accumulation axis.
+     * @param args a list of indices specifying the position in the accumulator.
+     * Indices must be unsigned integers, the number of indices should be equal
+     * or greater than the number of dimensions of the accumulator.
+     */
+    template <class F, class CT>
+    template <class... Args>
+    inline auto xaccumulator<F, CT>::operator()(Args... args) const -> const_reference
+    {
+        std::array<std::size_t, sizeof...(Args)> arg_array = {{static_cast<std::size_t>(args)...}};
+        return element(arg_array.cbegin(), arg_array.cend());
+    }
+
+    /**
+     * Returns the element at the specified position in the accumulator.
+     * @param index a sequence of indices specifying the position in the accumulator.
+     * Indices must be unsigned integers, the number of indices in the sequence should
+     * be equal or greater than the number of dimensions of the accumulator.
+     */
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::operator[](const xindex& index) const -> const_reference
+    {
+        return element(index.cbegin(), index.cend());
+    }
+
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::operator[](size_type i) const -> const_reference
+    {
+        return operator()(i);
+    }
+
+    /**
+     * Returns the element at the specified position in the accumulator.
+     * @param first iterator starting the sequence of indices
+     * @param last iterator ending the sequence of indices
+     * The number of indices in the sequence should be equal to or greater
+     * than the number of dimensions of the accumulator.
+     */
+    template <class F, class CT>
+    template <class It>
+    inline auto xaccumulator<F, CT>::element(It first, It last) const -> const_reference
+    {
+        auto st = m_e.stepper_begin(m_e.shape());
+        size_type nb_indices = size_type(std::distance(first, last));
+        if (nb_indices > dimension())
+        {
+            std::advance(first, nb_indices - dimension());
+        }
+        size_type n = 0;
+        for (size_type dim = 0; first != last; ++first, ++dim)
+        {
+            if (dim == m_axis)
+            {
+                n = size_type(*first);
+            }
+            else
+            {
+                st.step(dim, size_type(*first));
+            }
+        }
+        value_type res = *st;
+        for (size_type i = 0; i != n; ++i)
+        {
+            st.step(m_axis);
+            res = m_f(res, *st);
+        }
+        return res;
+    }
+    //@}
+
+    /**
+     * @name Broadcasting
+     */
+    //@{
+    /**
+     * Broadcast the shape of the accumulator to the specified parameter.
+     * @param shape the result shape
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class F, class CT>
+    template <class S>
+    inline bool xaccumulator<F, CT>::broadcast_shape(S& shape) const
+    {
+        return xt::broadcast_shape(m_e.shape(), shape);
+    }
+
+    /**
+     * Compares the specified strides with those of the container to see whether
+     * the broadcasting is trivial.
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class F, class CT>
+    template <class S>
+    inline bool xaccumulator<F, CT>::is_trivial_broadcast(const S& /*strides*/) const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * Calls \c f with the range of memory of the accumulated expression.
+     * @return false if the memory of the accumulated expression is unknown
+     * @sa visit_memory
+     */
+    template <class F, class CT>
+    template <class Func>
+    inline bool xaccumulator<F, CT>::visit_memory(Func&& f) const
+    {
+        return xt::visit_memory(m_e, f);
+    }
+    //@}
+
+    /**
+     * @name Steppers
+     */
+    //@{
+    /**
+     * Returns a stepper on the accumulator broadcast to \c shape. The
+     * accumulator is evaluated once into a buffer shared by all the steppers
+     * created for the same traversal, and freed with them.
+     * @param shape the shape of the traversal
+     */
+    template <class F, class CT>
+    template <class S>
+    inline auto xaccumulator<F, CT>::stepper_begin(const S& shape) const -> const_stepper
+    {
+        std::shared_ptr<const cache_type> c = cache();
+        auto st = c->stepper_begin(shape);
+        return const_stepper(std::move(c), st);
+    }
+
+    template <class F, class CT>
+    template <class S>
+    inline auto xaccumulator<F, CT>::stepper_end(const S& shape, layout_type l) const -> const_stepper
+    {
+        std::shared_ptr<const cache_type> c = cache();
+        auto st = c->stepper_end(shape, l);
+        return const_stepper(std::move(c), st);
+    }
+    //@}
+
+    /**
+     * Assigns the result of the accumulation to the container \c e. The
+     * elements are copied in row-major order into the storage of \c e, or
+     * into a temporary buffer if \c e cannot hold them, and accumulated in
+     * place along the axis.
+     */
+    template <class F, class CT>
+    template <class E>
+    inline void xaccumulator<F, CT>::assign_to(xexpression<E>& e) const
+    {
+        E& de = e.derived_cast();
+        xt::reshape(e, *this);
+        if (de.size() == 0)
+        {
+            return;
+        }
+        uvector<value_type> buffer;
+        value_type* out = detail::reducer_output(de, layout_type::row_major, buffer, std::is_same<typename E::value_type, value_type>());
+        std::copy(m_e.template cbegin<layout_type::row_major>(), m_e.template cend<layout_type::row_major>(), out);
+        detail::scan_in_place(m_f, out, shape(), m_axis);
+        if (!buffer.empty())
+        {
+            if (de.layout() == layout_type::row_major || de.dimension() <= 1)
+            {
+                std::copy(buffer.cbegin(), buffer.cend(), de.storage_begin());
+            }
+            else
+            {
+                std::copy(buffer.cbegin(), buffer.cend(), de.template begin<layout_type::row_major>());
+            }
+        }
+    }
+
+    template <class F, class CT>
+    inline auto xaccumulator<F, CT>::cache() const -> std::shared_ptr<const cache_type>
+    {
+        std::shared_ptr<const cache_type> c = m_cache.lock();
+        if (!c)
+        {
+            c = std::make_shared<const cache_type>(*this);
+            m_cache = c;
+        }
+        return c;
+    }
+
+    /***************************************
+     * xaccumulator_stepper implementation *
+     ***************************************/
+
+    template <class F, class CT>
+    inline xaccumulator_stepper<F, CT>::xaccumulator_stepper(std::shared_ptr<const cache_type> cache, cache_stepper st)
+        : m_cache(std::move(cache)), m_stepper(st)
+    {
+    }
+
+    template <class F, class CT>
+    inline auto xaccumulator_stepper<F, CT>::operator*() const -> reference
+    {
+        return *m_stepper;
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::step(size_type dim, size_type n)
+    {
+        m_stepper.step(dim, n);
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::step_back(size_type dim, size_type n)
+    {
+        m_stepper.step_back(dim, n);
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::reset(size_type dim)
+    {
+        m_stepper.reset(dim);
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::reset_back(size_type dim)
+    {
+        m_stepper.reset_back(dim);
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::to_begin()
+    {
+        m_stepper.to_begin();
+    }
+
+    template <class F, class CT>
+    inline void xaccumulator_stepper<F, CT>::to_end(layout_type l)
+    {
+        m_stepper.to_end(l);
+    }
+
+    template <class F, class CT>
+    inline bool xaccumulator_stepper<F, CT>::equal(const self_type& rhs) const
+    {
+        return m_cache == rhs.m_cache && m_stepper.equal(rhs.m_stepper);
+    }
+
+    template <class F, class CT>
+    inline bool operator==(const xaccumulator_stepper<F, CT>& lhs,
+                           const xaccumulator_stepper<F, CT>& rhs)
+    {
+        return lhs.equal(rhs);
+    }
+
+    template <class F, class CT>
+    inline bool operator!=(const xaccumulator_stepper<F, CT>& lhs,
+                           const xaccumulator_stepper<F, CT>& rhs)
+    {
+        return !lhs.equal(rhs);
+    }
+
+    /*****************************************
+     * accumulating functions implementation *
+     *****************************************/
+
+    /**
+     * @defgroup acc_functions accumulating functions
+     */
+
+    /**
+     * @ingroup acc_functions
+     * @brief Cumulative sum of elements along given axis.
+     *
+     * Returns an \ref xaccumulator for the cumulative sum of elements
+     * along \em axis.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the elements are summed
+     * @return an \ref xaccumulator
+     */
+    template <class E>
+    inline auto cumsum(E&& e, std::size_t axis)
+    {
+        using functor_type = detail::plus<typename std::decay_t<E>::value_type>;
+        return accumulate(functor_type(), std::forward<E>(e), axis);
+    }
+
+    /**
+     * @ingroup acc_functions
+     * @brief Cumulative product of elements along given axis.
+     *
+     * Returns an \ref xaccumulator for the cumulative product of elements
+     * along \em axis.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the elements are multiplied
+     * @return an \ref xaccumulator
+     */
+    template <class E>
+    inline auto cumprod(E&& e, std::size_t axis)
+    {
+        using functor_type = detail::multiplies<typename std::decay_t<E>::value_type>;
+        return accumulate(functor_type(), std::forward<E>(e), axis);
+    }
+
+    /**
+     * @ingroup acc_functions
+     * @brief Cumulative minimum of elements along given axis.
+     *
+     * Returns an \ref xaccumulator for the running minimum of elements
+     * along \em axis.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the minimum is computed
+     * @return an \ref xaccumulator
+     */
+    template <class E>
+    inline auto cummin(E&& e, std::size_t axis)
+    {
+        using functor_type = math::minimum<typename std::decay_t<E>::value_type>;
+        return accumulate(functor_type(), std::forward<E>(e), axis);
+    }
+
+    /**
+     * @ingroup acc_functions
+     * @brief Cumulative maximum of elements along given axis.
+     *
+     * Returns an \ref xaccumulator for the running maximum of elements
+     * along \em axis.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the maximum is computed
+     * @return an \ref xaccumulator
+     */
+    template <class E>
+    inline auto cummax(E&& e, std::size_t axis)
+    {
+        using functor_type = math::maximum<typename std::decay_t<E>::value_type>;
+        return accumulate(functor_type(), std::forward<E>(e), axis);
+    }
+}
+
+#endif
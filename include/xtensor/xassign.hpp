@@ -9,15 +9,29 @@
 #ifndef XASSIGN_HPP
 #define XASSIGN_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "xbatch.hpp"
+#include "xfunction.hpp"
 #include "xiterator.hpp"
+#include "xparallel.hpp"
+#include "xstage.hpp"
+#include "xstrides.hpp"
 #include "xtensor_forward.hpp"
-#include <algorithm>
 
 namespace xt
 {
     template <class E>
     class xexpression;
 
+    template <class D>
+    class xcontainer;
+
     /********************
      * Assign functions *
      ********************/
@@ -37,9 +51,41 @@ namespace xt
     template <class E1, class E2, class F>
     void scalar_computed_assign(xexpression<E1>& e1, const E2& e2, F&& f);
 
+    template <class... E1, class... E2>
+    void assign_all(std::tuple<E1&...> e1, const std::tuple<E2...>& e2);
+
     template <class E1, class E2>
     void assert_compatible_shape(const xexpression<E1>& e1, const xexpression<E2>& e2);
 
+    /******************
+     * traversal_plan *
+     ******************/
+
+    /**
+     * @class traversal_plan
+     * @brief Order of the dimensions traversed by data_assigner.
+     *
+     * Only the dimensions whose extent is greater than 1 are traversed;
+     * they are stored in \c order from the innermost to the outermost.
+     * When \c tiled is true, the two innermost dimensions are traversed
+     * by square tiles of XTENSOR_TILE_SIZE elements.
+     *
+     * @tparam S the shape type of the assigned expression
+     */
+    template <class S>
+    struct traversal_plan
+    {
+        using index_type = xindex_type_t<S>;
+        using size_type = typename index_type::value_type;
+
+        index_type order;
+        size_type nb_dims;
+        bool tiled;
+    };
+
+    template <layout_type L, class E1, class E2>
+    traversal_plan<typename E1::shape_type> make_traversal_plan(const E1& e1, const E2& e2);
+
     /*****************
      * data_assigner *
      *****************/
@@ -54,10 +100,13 @@ namespace xt
         using shape_type = typename E1::shape_type;
         using index_type = xindex_type_t<shape_type>;
         using size_type = typename lhs_iterator::size_type;
+        using plan_type = traversal_plan<shape_type>;
 
         data_assigner(E1& e1, const E2& e2);
+        data_assigner(E1& e1, const E2& e2, const plan_type& plan);
 
         void run();
+        void run(size_type first, size_type last);
 
         void step(size_type i);
         void reset(size_type i);
@@ -66,13 +115,20 @@ namespace xt
 
     private:
 
+        void run_merged(size_type first, size_type last);
+        void run_tiled(size_type first, size_type last);
+
+        size_type merged_dimensions(size_type first, size_type last, size_type& run_size) const;
+        bool increment_index(size_type rank, size_type last);
+
         E1& m_e1;
+        const E2& m_e2;
 
         lhs_iterator m_lhs;
         rhs_iterator m_rhs;
-        rhs_iterator m_rhs_end;
 
         index_type m_index;
+        plan_type m_plan;
     };
 
     /********************
@@ -86,6 +142,25 @@ namespace xt
         static void run(E1& e1, const E2& e2);
     };
 
+    /********************
+     * chunked_assigner *
+     ********************/
+
+    /**
+     * @class chunked_assigner
+     * @brief Contiguous assignment of expressions holding staged subexpressions.
+     *
+     * The assigned range is split into chunks whose staged subexpressions
+     * are evaluated into scratch buffers before the chunk is assigned.
+     *
+     * @sa xstage
+     */
+    struct chunked_assigner
+    {
+        template <class E1, class E2>
+        static void run(E1& e1, const E2& e2);
+    };
+
     /***********************************
      * Assign functions implementation *
      ***********************************/
@@ -93,16 +168,89 @@ namespace xt
     namespace detail
     {
         template <class E1, class E2>
-        inline bool is_trivial_broadcast(const E1& e1, const E2& e2)
+        inline auto is_trivial_broadcast_impl(const E1& e1, const E2& e2, int)
+            -> decltype(e2.is_trivial_broadcast(e1.strides()))
         {
             return e2.is_trivial_broadcast(e1.strides());
         }
 
+        // Expressions without strides, such as xindexview
+        template <class E1, class E2>
+        inline bool is_trivial_broadcast_impl(const E1&, const E2&, long)
+        {
+            return false;
+        }
+
+        template <class E1, class E2>
+        inline bool is_trivial_broadcast(const E1& e1, const E2& e2)
+        {
+            return is_trivial_broadcast_impl(e1, e2, 0);
+        }
+
         template <class D, class E2, class... SL>
         inline bool is_trivial_broadcast(const xview<D, SL...>&, const E2&)
         {
             return false;
         }
+
+        // Splits the outermost dimension of the traversal among the
+        // available threads. The steppers are built by the calling thread,
+        // workers only move and dereference them.
+        template <layout_type L, class E1, class E2>
+        inline void run_data_assigner(E1& e1, const E2& e2)
+        {
+            using assigner_type = data_assigner<E1, E2, L>;
+            using size_type = typename assigner_type::size_type;
+
+            auto plan = make_traversal_plan<L>(e1, e2);
+            size_type nb_chunks = 1;
+            size_type outer_size = 0;
+            if (plan.nb_dims != 0)
+            {
+                outer_size = e1.shape()[plan.order[plan.nb_dims - 1]];
+                size_type max_chunks = parallel_chunk_count(compute_size(e1.shape()), XTENSOR_PARALLEL_GRAIN_SIZE);
+                nb_chunks = std::min(max_chunks, outer_size);
+            }
+
+            if (nb_chunks <= 1)
+            {
+                assigner_type assigner(e1, e2, plan);
+                assigner.run();
+            }
+            else
+            {
+                std::vector<assigner_type> assigners;
+                assigners.reserve(nb_chunks);
+                for (size_type i = 0; i < nb_chunks; ++i)
+                {
+                    assigners.emplace_back(e1, e2, plan);
+                }
+                parallel_for_each_chunk(nb_chunks, [&assigners, outer_size, nb_chunks](std::size_t i) {
+                    assigners[i].run(outer_size * i / nb_chunks, outer_size * (i + 1) / nb_chunks);
+                });
+            }
+        }
+    }
+
+    namespace detail
+    {
+        template <bool contiguous_layout, class E1, class E2>
+        inline void run_trivial_assigner(E1& e1, const E2& e2, std::false_type /*has_stage*/)
+        {
+            trivial_assigner<contiguous_layout>::run(e1, e2);
+        }
+
+        // Staged subexpressions do not provide storage iterators: they are
+        // only evaluated by chunks when the whole assignment is contiguous.
+        template <bool contiguous_layout, class E1, class E2>
+        inline void run_trivial_assigner(E1& e1, const E2& e2, std::true_type /*has_stage*/)
+        {
+            static_if<contiguous_layout>([&](auto self) {
+                chunked_assigner::run(self(e1), e2);
+            }, /*else*/ [&](auto self) {
+                run_data_assigner<default_assignable_layout(E1::static_layout)>(self(e1), e2);
+            });
+        }
     }
 
     template <class E1, class E2>
@@ -115,33 +263,85 @@ namespace xt
         if (trivial_broadcast)
         {
             constexpr bool contiguous_layout = E1::contiguous_layout && E2::contiguous_layout;
-            trivial_assigner<contiguous_layout>::run(de1, de2);
+            detail::run_trivial_assigner<contiguous_layout>(de1, de2, has_stage<E2>());
         }
         else
         {
-            data_assigner<E1, E2, default_assignable_layout(E1::static_layout)> assigner(de1, de2);
-            assigner.run();
+            detail::run_data_assigner<default_assignable_layout(E1::static_layout)>(de1, de2);
+        }
+    }
+
+    namespace detail
+    {
+        template <class E, class = void>
+        struct has_cached_broadcast : std::false_type
+        {
+        };
+
+        template <class E>
+        struct has_cached_broadcast<E, typename enable_if_type<decltype(std::declval<const E&>().has_trivial_broadcast())>::type>
+            : std::true_type
+        {
+        };
+
+        template <class E1, class E2>
+        using use_cached_shape = std::integral_constant<bool, has_cached_broadcast<E2>::value &&
+                                                                  std::is_same<typename E1::shape_type, typename E2::shape_type>::value>;
+
+        template <class E1, class E2>
+        inline bool reshape_impl(E1& e1, const E2& e2, std::false_type)
+        {
+            using shape_type = typename E1::shape_type;
+            using size_type = typename E1::size_type;
+            size_type size = e2.dimension();
+            shape_type shape = make_sequence<shape_type>(size, size_type(1));
+            bool trivial_broadcast = e2.broadcast_shape(shape);
+            e1.reshape(shape);
+            return trivial_broadcast;
+        }
+
+        // The shape of the expression and the triviality of its broadcasting
+        // are computed once, no shape needs to be built for the assignment.
+        // Shapes of other types are still converted by the generic version.
+        template <class E1, class E2>
+        inline bool reshape_impl(E1& e1, const E2& e2, std::true_type)
+        {
+            e1.reshape(e2.shape());
+            return e2.has_trivial_broadcast();
         }
     }
 
     template <class E1, class E2>
     inline bool reshape(xexpression<E1>& e1, const xexpression<E2>& e2)
     {
-        using shape_type = typename E1::shape_type;
-        using size_type = typename E1::size_type;
-        const E2& de2 = e2.derived_cast();
-        size_type size = de2.dimension();
-        shape_type shape = make_sequence<shape_type>(size, size_type(1));
-        bool trivial_broadcast = de2.broadcast_shape(shape);
-        e1.derived_cast().reshape(shape);
-        return trivial_broadcast;
+        return detail::reshape_impl(e1.derived_cast(), e2.derived_cast(), detail::use_cached_shape<E1, E2>());
     }
 
+    namespace detail
+    {
+        template <class E1, class E2, class = void>
+        struct has_assign_to : std::false_type
+        {
+        };
+
+        template <class E1, class E2>
+        struct has_assign_to<E1, E2, typename enable_if_type<decltype(std::declval<const E2&>().assign_to(std::declval<xexpression<E1>&>()))>::type>
+            : std::true_type
+        {
+        };
+    }
+
+    // Expressions that are evaluated more efficiently than element by
+    // element, such as reducers, provide an assign_to method.
     template <class E1, class E2>
     inline void assign_xexpression(xexpression<E1>& e1, const xexpression<E2>& e2)
     {
-        bool trivial_broadcast = reshape(e1, e2);
-        assign_data(e1, e2, trivial_broadcast);
+        static_if<detail::has_assign_to<E1, E2>::value>([&](auto self) {
+            self(e2).derived_cast().assign_to(e1);
+        }, /*else*/ [&](auto self) {
+            bool trivial_broadcast = reshape(self(e1), e2);
+            assign_data(e1, e2, trivial_broadcast);
+        });
     }
 
     template <class E1, class E2>
@@ -169,12 +369,95 @@ namespace xt
         }
     }
 
+    namespace detail
+    {
+        template <class E>
+        using has_container_storage = std::is_base_of<xcontainer<E>, E>;
+
+        // The batch loop is used only when f(v, e) is computed with the
+        // value type T of the container, so that converting the scalar
+        // before the loop does not change the result.
+        template <class T, class E, class F, class = void>
+        struct use_simd_scalar_assign : std::false_type
+        {
+        };
+
+        template <class T, class E, class F>
+        struct use_simd_scalar_assign<T, E, F, typename enable_if_type<decltype(std::declval<F&>()(std::declval<const xsimd_batch_t<T>&>(), std::declval<const xsimd_batch_t<T>&>()))>::type>
+            : std::integral_constant<bool, has_simd<T>::value && std::is_arithmetic<E>::value &&
+                                               std::is_same<std::decay_t<decltype(std::declval<F&>()(std::declval<const T&>(), std::declval<const E&>()))>, T>::value>
+        {
+        };
+
+        template <bool simd>
+        struct scalar_computed_loop
+        {
+            template <class T, class E, class F, class S>
+            static void run(T* data, const E& e, F& f, S first, S last)
+            {
+                for (S i = first; i < last; ++i)
+                {
+                    data[i] = static_cast<T>(f(data[i], e));
+                }
+            }
+        };
+
+        template <>
+        struct scalar_computed_loop<true>
+        {
+            template <class T, class E, class F, class S>
+            static void run(T* data, const E& e, F& f, S first, S last)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                const batch_type be(static_cast<T>(e));
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                S i = first;
+                for (; i < simd_last; i += batch_size)
+                {
+                    batch_type b = f(batch_type::load_unaligned(data + i), be);
+                    b.store_unaligned(data + i);
+                }
+                for (; i < last; ++i)
+                {
+                    data[i] = static_cast<T>(f(data[i], e));
+                }
+            }
+        };
+
+        template <class E1, class E2, class F>
+        inline void scalar_computed_assign_impl(E1& e1, const E2& e2, F& f, std::true_type)
+        {
+            using value_type = typename E1::value_type;
+            using size_type = typename E1::size_type;
+            using loop_type = scalar_computed_loop<use_simd_scalar_assign<value_type, E2, F>::value>;
+            value_type* data = e1.raw_data();
+            parallel_for(e1.data().size(), XTENSOR_PARALLEL_GRAIN_SIZE, [data, &e2, &f](size_type first, size_type last) {
+                loop_type::run(data, e2, f, first, last);
+            });
+        }
+
+        template <class E1, class E2, class F>
+        inline void scalar_computed_assign_impl(E1& e1, const E2& e2, F& f, std::false_type)
+        {
+            using function_type = xfunction<std::decay_t<F>, typename E1::value_type, const E1&, xscalar<const E2&>>;
+            assign_data(e1, function_type(f, e1, xscalar<const E2&>(e2)), false);
+        }
+    }
+
+    /**
+     * Applies \c f(v, e2) to each value \c v of \c e1 and stores the result
+     * in place. Containers are traversed through their contiguous storage,
+     * with batches of values when \c f supports them; other expressions,
+     * such as views, go through the data assigner, like computed_assign.
+     */
     template <class E1, class E2, class F>
     inline void scalar_computed_assign(xexpression<E1>& e1, const E2& e2, F&& f)
     {
         E1& d = e1.derived_cast();
-        std::transform(d.cbegin(), d.cend(), d.begin(),
-                       [e2, &f](const auto& v) { return f(v, e2); });
+        // e2 may refer to a value of e1
+        const E2 value = e2;
+        detail::scalar_computed_assign_impl(d, value, f, detail::has_container_storage<E1>());
     }
 
     template <class E1, class E2>
@@ -193,26 +476,287 @@ namespace xt
         }
     }
 
+    /*********************************
+     * traversal_plan implementation *
+     *********************************/
+
+    /**
+     * Computes the order in which the dimensions are traversed when
+     * assigning \c e2 to \c e1. The dimensions are sorted by increasing
+     * sum of the strides of \c e1 and of the leaves of \c e2, so that the
+     * innermost loop reads and writes memory as contiguously as possible.
+     * If the innermost dimensions of \c e1 and \c e2 differ, as when
+     * assigning a transposed expression, both are traversed by tiles.
+     * When the strides of one of the expressions are unknown, the order
+     * is the one defined by \c L.
+     */
+    template <layout_type L, class E1, class E2>
+    inline auto make_traversal_plan(const E1& e1, const E2& e2) -> traversal_plan<typename E1::shape_type>
+    {
+        using plan_type = traversal_plan<typename E1::shape_type>;
+        using index_type = typename plan_type::index_type;
+        using size_type = typename plan_type::size_type;
+
+        const auto& shape = e1.shape();
+        size_type dim = shape.size();
+        plan_type plan;
+        plan.order = make_sequence<index_type>(dim, size_type(0));
+        plan.nb_dims = 0;
+        plan.tiled = false;
+        for (size_type r = 0; r < dim; ++r)
+        {
+            size_type d = L == layout_type::column_major ? r : dim - 1 - r;
+            if (shape[d] != 1)
+            {
+                plan.order[plan.nb_dims++] = d;
+            }
+        }
+        if (plan.nb_dims < 2)
+        {
+            return plan;
+        }
+
+        index_type lhs_cost = make_sequence<index_type>(dim, size_type(0));
+        index_type rhs_cost = make_sequence<index_type>(dim, size_type(0));
+        auto cost_visitor = [&shape, dim](index_type& cost) {
+            return [&shape, &cost, dim](const auto& strides) {
+                for (size_type d = 0; d < dim; ++d)
+                {
+                    cost[d] += broadcast_stride(shape, strides, d);
+                }
+            };
+        };
+        if (!(visit_strides(e1, cost_visitor(lhs_cost)) && visit_strides(e2, cost_visitor(rhs_cost))))
+        {
+            return plan;
+        }
+
+        auto first = plan.order.begin();
+        auto last = first + static_cast<std::ptrdiff_t>(plan.nb_dims);
+        std::stable_sort(first, last, [&lhs_cost, &rhs_cost](size_type d1, size_type d2) {
+            return lhs_cost[d1] + rhs_cost[d1] < lhs_cost[d2] + rhs_cost[d2];
+        });
+
+        auto lhs_inner = *std::min_element(first, last, [&lhs_cost](size_type d1, size_type d2) {
+            return lhs_cost[d1] < lhs_cost[d2];
+        });
+        auto rhs_inner = *std::min_element(first, last, [&rhs_cost](size_type d1, size_type d2) {
+            return rhs_cost[d1] < rhs_cost[d2];
+        });
+        size_type tile_size = XTENSOR_TILE_SIZE;
+        if (lhs_inner != rhs_inner && rhs_cost[lhs_inner] > rhs_cost[rhs_inner] &&
+            lhs_cost[rhs_inner] > lhs_cost[lhs_inner] &&
+            shape[lhs_inner] >= 2 * tile_size && shape[rhs_inner] >= 2 * tile_size)
+        {
+            std::stable_partition(first, last, [lhs_inner, rhs_inner](size_type d) {
+                return d == lhs_inner || d == rhs_inner;
+            });
+            plan.order[0] = lhs_inner;
+            plan.order[1] = rhs_inner;
+            plan.tiled = true;
+        }
+        return plan;
+    }
+
     /********************************
      * data_assigner implementation *
      ********************************/
 
     template <class E1, class E2, layout_type L>
     inline data_assigner<E1, E2, L>::data_assigner(E1& e1, const E2& e2)
-        : m_e1(e1), m_lhs(e1.stepper_begin(e1.shape())),
-          m_rhs(e2.stepper_begin(e1.shape())), m_rhs_end(e2.stepper_end(e1.shape(), L)),
-          m_index(make_sequence<index_type>(e1.shape().size(), size_type(0)))
+        : data_assigner(e1, e2, make_traversal_plan<L>(e1, e2))
+    {
+    }
+
+    template <class E1, class E2, layout_type L>
+    inline data_assigner<E1, E2, L>::data_assigner(E1& e1, const E2& e2, const plan_type& plan)
+        : m_e1(e1), m_e2(e2), m_lhs(e1.stepper_begin(e1.shape())),
+          m_rhs(e2.stepper_begin(e1.shape())),
+          m_index(make_sequence<index_type>(e1.shape().size(), size_type(0))),
+          m_plan(plan)
     {
     }
 
     template <class E1, class E2, layout_type L>
     inline void data_assigner<E1, E2, L>::run()
     {
-        while (m_rhs != m_rhs_end)
+        if (m_plan.nb_dims == 0)
+        {
+            if (compute_size(m_e1.shape()) != 0)
+            {
+                *m_lhs = *m_rhs;
+            }
+        }
+        else
+        {
+            run(0, m_e1.shape()[m_plan.order[m_plan.nb_dims - 1]]);
+        }
+    }
+
+    /**
+     * Assigns the elements whose index along the outermost dimension of
+     * the traversal plan lies in [first, last).
+     */
+    template <class E1, class E2, layout_type L>
+    inline void data_assigner<E1, E2, L>::run(size_type first, size_type last)
+    {
+        const auto& shape = m_e1.shape();
+        if (first >= last || std::find(shape.cbegin(), shape.cend(), size_type(0)) != shape.cend())
+        {
+            return;
+        }
+
+        size_type outer = m_plan.order[m_plan.nb_dims - 1];
+        m_index[outer] = first;
+        m_lhs.step(outer, first);
+        m_rhs.step(outer, first);
+
+        if (m_plan.tiled)
         {
+            run_tiled(first, last);
+        }
+        else
+        {
+            run_merged(first, last);
+        }
+    }
+
+    // The innermost dimensions that both sides can traverse with a single
+    // stride are merged and assigned by a tight loop; the multi-index is
+    // only updated at the end of such a run.
+    template <class E1, class E2, layout_type L>
+    inline void data_assigner<E1, E2, L>::run_merged(size_type first, size_type last)
+    {
+        size_type inner = m_plan.order[0];
+        size_type run_size = 0;
+        size_type nb_merged = merged_dimensions(first, last, run_size);
+        do
+        {
+            for (size_type i = 1; i < run_size; ++i)
+            {
+                *m_lhs = *m_rhs;
+                m_lhs.step(inner);
+                m_rhs.step(inner);
+            }
             *m_lhs = *m_rhs;
-            stepper_tools<L>::increment_stepper(*this, m_index, m_e1.shape());
+            m_lhs.step_back(inner, run_size - 1);
+            m_rhs.step_back(inner, run_size - 1);
+        } while (increment_index(nb_merged, last));
+    }
+
+    // Traverses the two innermost dimensions of the plan by square tiles,
+    // so that both the lhs and the rhs rows of a tile stay in cache.
+    template <class E1, class E2, layout_type L>
+    inline void data_assigner<E1, E2, L>::run_tiled(size_type first, size_type last)
+    {
+        const auto& shape = m_e1.shape();
+        size_type tile_size = XTENSOR_TILE_SIZE;
+        size_type a = m_plan.order[0];
+        size_type b = m_plan.order[1];
+        bool b_outer = m_plan.nb_dims == 2;
+        size_type a_size = shape[a];
+        size_type b_first = b_outer ? first : size_type(0);
+        size_type b_last = b_outer ? last : shape[b];
+
+        auto move = [this](size_type d, size_type from, size_type to) {
+            if (to > from)
+            {
+                m_lhs.step(d, to - from);
+                m_rhs.step(d, to - from);
+            }
+            else if (from > to)
+            {
+                m_lhs.step_back(d, from - to);
+                m_rhs.step_back(d, from - to);
+            }
+        };
+
+        do
+        {
+            size_type pos_a = 0;
+            size_type pos_b = b_first;
+            for (size_type tb = b_first; tb < b_last; tb += tile_size)
+            {
+                size_type tb_end = std::min(tb + tile_size, b_last);
+                for (size_type ta = 0; ta < a_size; ta += tile_size)
+                {
+                    size_type ta_end = std::min(ta + tile_size, a_size);
+                    for (size_type ib = tb; ib < tb_end; ++ib)
+                    {
+                        move(b, pos_b, ib);
+                        move(a, pos_a, ta);
+                        pos_b = ib;
+                        *m_lhs = *m_rhs;
+                        for (size_type ia = ta + 1; ia < ta_end; ++ia)
+                        {
+                            m_lhs.step(a);
+                            m_rhs.step(a);
+                            *m_lhs = *m_rhs;
+                        }
+                        pos_a = ta_end - 1;
+                    }
+                }
+            }
+            move(a, pos_a, 0);
+            move(b, pos_b, b_first);
+        } while (increment_index(2, last));
+    }
+
+    // Returns the number of innermost dimensions of the plan that can be
+    // traversed as a single one, and the number of elements of such a run
+    // in run_size.
+    template <class E1, class E2, layout_type L>
+    inline auto data_assigner<E1, E2, L>::merged_dimensions(size_type first, size_type last,
+                                                            size_type& run_size) const -> size_type
+    {
+        const auto& shape = m_e1.shape();
+        size_type outer = m_plan.order[m_plan.nb_dims - 1];
+        auto extent = [&shape, outer, first, last](size_type d) { return d == outer ? last - first : shape[d]; };
+
+        run_size = extent(m_plan.order[0]);
+        size_type nb_merged = 1;
+        while (nb_merged < m_plan.nb_dims)
+        {
+            size_type d = m_plan.order[nb_merged];
+            size_type prev = m_plan.order[nb_merged - 1];
+            // Stepping along the innermost dimension crosses the merged ones,
+            // which requires a constant stride over the whole run.
+            if (!(is_mergeable(m_e1, shape, d, prev) && is_mergeable(m_e2, shape, d, prev)))
+            {
+                break;
+            }
+            run_size *= extent(d);
+            ++nb_merged;
+        }
+        return nb_merged;
+    }
+
+    // Increments the multi-index restricted to the dimensions of the plan
+    // whose rank is greater or equal to rank, and moves the steppers
+    // accordingly. Returns false when the traversal is over.
+    template <class E1, class E2, layout_type L>
+    inline bool data_assigner<E1, E2, L>::increment_index(size_type rank, size_type last)
+    {
+        const auto& shape = m_e1.shape();
+        size_type outer = m_plan.order[m_plan.nb_dims - 1];
+        for (; rank < m_plan.nb_dims; ++rank)
+        {
+            size_type d = m_plan.order[rank];
+            size_type end = d == outer ? last : shape[d];
+            if (m_index[d] + 1 != end)
+            {
+                ++m_index[d];
+                step(d);
+                return true;
+            }
+            if (d == outer)
+            {
+                return false;
+            }
+            m_index[d] = 0;
+            reset(d);
         }
+        return false;
     }
 
     template <class E1, class E2, layout_type L>
@@ -240,16 +784,113 @@ namespace xt
      * trivial_assigner implementation *
      ***********************************/
 
+    namespace detail
+    {
+        template <class E1, class E2>
+        struct use_simd_assign
+        {
+            static constexpr bool value = has_simd_interface<E1>::value && has_simd_interface<E2>::value &&
+                std::is_same<typename E1::value_type, typename E2::value_type>::value;
+        };
+
+        template <bool simd>
+        struct trivial_loop
+        {
+            template <class E1, class E2, class S>
+            static void run(E1& e1, const E2& e2, S first, S last, bool /*stream*/)
+            {
+                for (S i = first; i < last; ++i)
+                {
+                    e1.data_element(i) = e2.data_element(i);
+                }
+            }
+        };
+
+        template <>
+        struct trivial_loop<true>
+        {
+            // The first values are assigned one by one up to an index that is
+            // a multiple of the batch size, so that the batches are loaded and
+            // stored in aligned_mode: expressions whose data is aligned for
+            // batches use aligned instructions, without any runtime check.
+            // When stream is true, the batches are written with non-temporal
+            // stores, which require aligned addresses: if the alignment of the
+            // destination is not known at compile time, the first values are
+            // assigned one by one until it is aligned.
+            template <class E1, class E2, class S>
+            static void run(E1& e1, const E2& e2, S first, S last, bool stream)
+            {
+                using value_type = typename E1::value_type;
+                using batch_type = xsimd_batch_t<value_type>;
+                constexpr S batch_size = xsimd_traits<value_type>::size;
+                constexpr std::size_t alignment = xsimd_traits<value_type>::alignment;
+                constexpr bool aligned_data = E1::data_alignment >= alignment;
+                value_type* data = e1.raw_data();
+                S i = first;
+                if (stream && !aligned_data)
+                {
+                    for (; i < last && reinterpret_cast<std::uintptr_t>(data + i) % alignment != 0; ++i)
+                    {
+                        e1.data_element(i) = e2.data_element(i);
+                    }
+                    S simd_last = i + (last - i) / batch_size * batch_size;
+                    for (; i < simd_last; i += batch_size)
+                    {
+                        e2.template load_batch<batch_type>(i).store_stream(data + i);
+                    }
+                    stream_fence();
+                }
+                else
+                {
+                    S simd_first = std::min(last, (first + batch_size - 1) / batch_size * batch_size);
+                    for (; i < simd_first; ++i)
+                    {
+                        e1.data_element(i) = e2.data_element(i);
+                    }
+                    S simd_last = i + (last - i) / batch_size * batch_size;
+                    if (stream)
+                    {
+                        for (; i < simd_last; i += batch_size)
+                        {
+                            e2.template load_batch<batch_type, aligned_mode>(i).store_stream(data + i);
+                        }
+                        stream_fence();
+                    }
+                    else
+                    {
+                        for (; i < simd_last; i += batch_size)
+                        {
+                            e1.template store_batch<batch_type, aligned_mode>(i, e2.template load_batch<batch_type, aligned_mode>(i));
+                        }
+                    }
+                }
+                for (; i < last; ++i)
+                {
+                    e1.data_element(i) = e2.data_element(i);
+                }
+            }
+        };
+
+        // Non-temporal stores avoid reading the destination into the cache
+        // when it is too large to stay there anyway.
+        template <class E>
+        inline bool use_streaming_store(const E& e) noexcept
+        {
+            std::size_t threshold = XTENSOR_STREAMING_THRESHOLD;
+            return threshold != 0 && e.size() * sizeof(typename E::value_type) >= threshold;
+        }
+    }
+
     template <bool index_assign>
     template <class E1, class E2>
     inline void trivial_assigner<index_assign>::run(E1& e1, const E2& e2)
     {
         using size_type = typename E1::size_type;
-        size_type size = e1.size();
-        for (size_type i = 0; i < size; ++i)
-        {
-            e1.data_element(i) = e2.data_element(i);
-        }
+        using loop_type = detail::trivial_loop<detail::use_simd_assign<E1, E2>::value>;
+        bool stream = detail::use_streaming_store(e1);
+        parallel_for(e1.size(), XTENSOR_PARALLEL_GRAIN_SIZE, [&e1, &e2, stream](size_type first, size_type last) {
+            loop_type::run(e1, e2, first, last, stream);
+        });
     }
 
     template <>
@@ -258,6 +899,367 @@ namespace xt
     {
         std::copy(e2.storage_cbegin(), e2.storage_cend(), e1.storage_begin());
     }
+
+    /***********************************
+     * chunked_assigner implementation *
+     ***********************************/
+
+    namespace detail
+    {
+        inline std::size_t floor_power_of_two(std::size_t n) noexcept
+        {
+            std::size_t res = 1;
+            while (res <= n / 2)
+            {
+                res *= 2;
+            }
+            return res;
+        }
+
+        // Frees the scratch buffers of the stages when the assignment ends,
+        // including when it throws.
+        template <class E>
+        class stage_buffers
+        {
+        public:
+
+            explicit stage_buffers(const E& e) noexcept
+                : m_e(e)
+            {
+            }
+
+            ~stage_buffers()
+            {
+                visit_stages(m_e, [](const auto& s) { s.release_chunks(); });
+            }
+
+            stage_buffers(const stage_buffers&) = delete;
+            stage_buffers& operator=(const stage_buffers&) = delete;
+
+        private:
+
+            const E& m_e;
+        };
+    }
+
+    /**
+     * Assigns \c e2 to \c e1 by chunks of XTENSOR_CHUNK_SIZE bytes. Each
+     * thread assigns every n-th chunk, with n a power of two, so that the
+     * chunks evaluated at the same time use different parts of the
+     * scratch buffers.
+     */
+    template <class E1, class E2>
+    inline void chunked_assigner::run(E1& e1, const E2& e2)
+    {
+        using value_type = typename E1::value_type;
+        using size_type = typename E1::size_type;
+        using loop_type = detail::trivial_loop<detail::use_simd_assign<E1, E2>::value>;
+
+        size_type chunk_size = detail::floor_power_of_two(std::max(std::size_t(XTENSOR_CHUNK_SIZE) / sizeof(value_type), std::size_t(64)));
+        size_type size = e1.size();
+        size_type nb_chunks = (size + chunk_size - 1) / chunk_size;
+        size_type nb_tasks = detail::floor_power_of_two(parallel_chunk_count(size, std::max(size_type(XTENSOR_PARALLEL_GRAIN_SIZE), chunk_size)));
+
+        detail::stage_buffers<E2> buffers(e2);
+        visit_stages(e2, [chunk_size, nb_tasks](const auto& s) { s.reserve_chunks(chunk_size, nb_tasks); });
+
+        bool stream = detail::use_streaming_store(e1);
+        parallel_for_each_chunk(nb_tasks, [&e1, &e2, chunk_size, size, nb_chunks, nb_tasks, stream](std::size_t task) {
+            for (size_type c = task; c < nb_chunks; c += nb_tasks)
+            {
+                size_type first = c * chunk_size;
+                size_type last = std::min(first + chunk_size, size);
+                visit_stages(e2, [first, last](const auto& s) { s.prepare_chunk(first, last); });
+                loop_type::run(e1, e2, first, last, stream);
+            }
+        });
+    }
+
+    /*****************************
+     * assign_all implementation *
+     *****************************/
+
+    namespace detail
+    {
+        // Stepper moving a set of steppers together; dereferencing it
+        // gives the tuple of the values they point to.
+        template <class... S>
+        class xmulti_stepper
+        {
+        public:
+
+            using size_type = typename std::tuple_element_t<0, std::tuple<S...>>::size_type;
+            using reference = std::tuple<decltype(*std::declval<const S&>())...>;
+
+            explicit xmulti_stepper(S... s)
+                : m_s(std::move(s)...)
+            {
+            }
+
+            reference operator*() const
+            {
+                return deref(std::make_index_sequence<sizeof...(S)>());
+            }
+
+            void step(size_type dim, size_type n = 1)
+            {
+                for_each([dim, n](auto& s) { s.step(dim, n); }, m_s);
+            }
+
+            void step_back(size_type dim, size_type n = 1)
+            {
+                for_each([dim, n](auto& s) { s.step_back(dim, n); }, m_s);
+            }
+
+            void reset(size_type dim)
+            {
+                for_each([dim](auto& s) { s.reset(dim); }, m_s);
+            }
+
+            void reset_back(size_type dim)
+            {
+                for_each([dim](auto& s) { s.reset_back(dim); }, m_s);
+            }
+
+            void to_begin()
+            {
+                for_each([](auto& s) { s.to_begin(); }, m_s);
+            }
+
+            void to_end(layout_type l)
+            {
+                for_each([l](auto& s) { s.to_end(l); }, m_s);
+            }
+
+        private:
+
+            template <std::size_t... I>
+            reference deref(std::index_sequence<I...>) const
+            {
+                return reference(*std::get<I>(m_s)...);
+            }
+
+            std::tuple<S...> m_s;
+        };
+
+        template <class CT>
+        struct multi_stepper_type
+        {
+            using type = typename std::decay_t<CT>::stepper;
+        };
+
+        template <class E>
+        struct multi_stepper_type<const E&>
+        {
+            using type = typename E::const_stepper;
+        };
+
+        // Set of expressions of the same shape, providing the part of the
+        // expression interface used by data_assigner.
+        template <class... CT>
+        class xmulti_expression
+        {
+        public:
+
+            using first_type = std::decay_t<std::tuple_element_t<0, std::tuple<CT...>>>;
+            using shape_type = typename first_type::shape_type;
+            using size_type = typename first_type::size_type;
+            using stepper = xmulti_stepper<typename multi_stepper_type<CT>::type...>;
+            using const_stepper = stepper;
+
+            xmulti_expression(const shape_type& shape, CT... e)
+                : m_e(e...), m_shape(shape)
+            {
+            }
+
+            const shape_type& shape() const noexcept
+            {
+                return m_shape;
+            }
+
+            template <class S>
+            stepper stepper_begin(const S& shape) const
+            {
+                return build_stepper(shape, std::make_index_sequence<sizeof...(CT)>());
+            }
+
+            template <class F>
+            bool visit_strides(F&& f) const
+            {
+                auto func = [&f](bool b, auto&& e) { return b && xt::visit_strides(e, f); };
+                return accumulate(func, true, m_e);
+            }
+
+        private:
+
+            template <class S, std::size_t... I>
+            stepper build_stepper(const S& shape, std::index_sequence<I...>) const
+            {
+                return stepper(std::get<I>(m_e).stepper_begin(shape)...);
+            }
+
+            std::tuple<CT...> m_e;
+            shape_type m_shape;
+        };
+
+        template <class S1, class S2>
+        inline void check_same_shape(const S1& s1, const S2& s2)
+        {
+            if (s1.size() != s2.size() || !std::equal(s1.cbegin(), s1.cend(), s2.cbegin()))
+            {
+                throw broadcast_error(s1, s2);
+            }
+        }
+
+        template <class E1, class E2>
+        struct assign_pair
+        {
+            E1& lhs;
+            const E2& rhs;
+
+            // Shape of lhs once prepared: the shape of rhs for containers,
+            // which are resized, the shape of lhs otherwise.
+            std::vector<std::size_t> target_shape() const
+            {
+                return target_shape_impl(has_container_storage<E1>());
+            }
+
+            std::vector<std::size_t> target_shape_impl(std::true_type) const
+            {
+                auto shape = make_sequence<std::vector<std::size_t>>(rhs.dimension(), std::size_t(1));
+                rhs.broadcast_shape(shape);
+                return shape;
+            }
+
+            std::vector<std::size_t> target_shape_impl(std::false_type) const
+            {
+                std::vector<std::size_t> shape(lhs.shape().cbegin(), lhs.shape().cend());
+                rhs.broadcast_shape(shape);
+                check_same_shape(shape, lhs.shape());
+                return shape;
+            }
+
+            // Resizes containers to the shape of rhs; returns whether
+            // the broadcasting of rhs is trivial.
+            bool prepare()
+            {
+                return prepare_impl(has_container_storage<E1>());
+            }
+
+            bool prepare_impl(std::true_type)
+            {
+                return reshape(lhs, rhs);
+            }
+
+            bool prepare_impl(std::false_type)
+            {
+                assert_compatible_shape(lhs, rhs);
+                return false;
+            }
+
+            template <class S>
+            void run_trivial(S first, S last, bool stream)
+            {
+                trivial_loop<use_simd_assign<E1, E2>::value>::run(lhs, rhs, first, last, stream);
+            }
+        };
+
+        // The values are assigned by index when all the containers have the
+        // same strides and all the expressions broadcast trivially. They are
+        // processed by blocks small enough for the inputs to stay in cache
+        // from an output to the next one. Returns false if the assignment
+        // is not trivial.
+        template <class P, class E>
+        inline bool run_trivial_assign_all(P& pairs, const E& e, std::true_type)
+        {
+            using size_type = typename E::size_type;
+            const auto& strides = e.strides();
+            bool trivial = true;
+            for_each([&trivial, &strides](auto& p) {
+                const auto& str = p.lhs.strides();
+                trivial = trivial && str.size() == strides.size() &&
+                    std::equal(str.cbegin(), str.cend(), strides.cbegin()) &&
+                    is_trivial_broadcast(p.lhs, p.rhs);
+            }, pairs);
+            if (!trivial)
+            {
+                return false;
+            }
+
+            size_type block_size = XTENSOR_TILE_SIZE * XTENSOR_TILE_SIZE;
+            bool stream = use_streaming_store(e);
+            parallel_for(e.size(), XTENSOR_PARALLEL_GRAIN_SIZE, [&pairs, block_size, stream](size_type first, size_type last) {
+                for (size_type i = first; i < last; i += block_size)
+                {
+                    size_type block_last = std::min(i + block_size, last);
+                    for_each([i, block_last, stream](auto& p) { p.run_trivial(i, block_last, stream); }, pairs);
+                }
+            });
+            return true;
+        }
+
+        template <class P, class E>
+        inline bool run_trivial_assign_all(P&, const E&, std::false_type)
+        {
+            return false;
+        }
+
+        template <class... E1, class... E2, std::size_t... I>
+        inline void assign_all_impl(std::tuple<E1&...>& e1, const std::tuple<E2...>& e2, std::index_sequence<I...>)
+        {
+            using first_type = std::tuple_element_t<0, std::tuple<E1...>>;
+            using contiguous = and_c<(E1::contiguous_layout && std::decay_t<E2>::contiguous_layout)...>;
+
+            auto pairs = std::make_tuple(assign_pair<E1, std::decay_t<E2>>{std::get<I>(e1), std::get<I>(e2)}...);
+            // The shapes are checked before any container is resized, so
+            // that the containers are left unchanged when they differ.
+            std::vector<std::size_t> shapes[] = {std::get<I>(pairs).target_shape()...};
+            int checked[] = {(check_same_shape(shapes[I], shapes[0]), 0)...};
+            (void)checked;
+
+            // The elements of a braced list are evaluated in order
+            bool prepared[] = {std::get<I>(pairs).prepare()...};
+            bool trivial = std::find(std::begin(prepared), std::end(prepared), false) == std::end(prepared);
+
+            const first_type& first = std::get<0>(e1);
+            const auto& shape = first.shape();
+
+            if (!(trivial && run_trivial_assign_all(pairs, first, contiguous())))
+            {
+                using lhs_type = xmulti_expression<E1&...>;
+                using rhs_type = xmulti_expression<const std::decay_t<E2>&...>;
+                typename lhs_type::shape_type lhs_shape = shape;
+                lhs_type lhs(lhs_shape, std::get<I>(e1)...);
+                rhs_type rhs(lhs_shape, std::get<I>(e2)...);
+                run_data_assigner<default_assignable_layout(first_type::static_layout)>(lhs, rhs);
+            }
+        }
+    }
+
+    /**
+     * Assigns each expression of \c e2 to the corresponding expression of
+     * \c e1 in a single traversal, so that the values shared by several
+     * expressions are read only once:
+     *
+     * \code{.cpp}
+     * xt::assign_all(std::tie(a, b, c), std::make_tuple(x + y, x * y, sqrt(x)));
+     * \endcode
+     *
+     * Containers are resized to the shape of their expression; all the
+     * assigned expressions must then have the same shape. As with noalias,
+     * no temporary is used: the expressions must not depend on the
+     * assigned containers.
+     * @param e1 the tuple of references to the assigned expressions
+     * @param e2 the tuple of expressions to assign
+     * @throw broadcast_error if the shapes are incompatible
+     */
+    template <class... E1, class... E2>
+    inline void assign_all(std::tuple<E1&...> e1, const std::tuple<E2...>& e2)
+    {
+        static_assert(sizeof...(E1) == sizeof...(E2), "assign_all requires as many expressions as assigned ones");
+        static_assert(sizeof...(E1) != 0, "assign_all requires at least one expression");
+        detail::assign_all_impl(e1, e2, std::make_index_sequence<sizeof...(E1)>());
+    }
 }
 
 #endif
@@ -0,0 +1,655 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XBATCH_HPP
+#define XBATCH_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "xtensor_config.hpp"
+#include "xutils.hpp"
+
+#if defined(XTENSOR_USE_SIMD)
+    #if defined(__AVX__)
+        #define XTENSOR_SIMD_AVX
+        #include <immintrin.h>
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define XTENSOR_SIMD_SSE2
+        #include <emmintrin.h>
+    #endif
+#endif
+
+namespace xt
+{
+
+    /****************
+     * xsimd_traits *
+     ****************/
+
+    /**
+     * @class xsimd_traits
+     * @brief SIMD properties of a scalar type.
+     *
+     * The xsimd_traits class gives the batch type used to process
+     * values of type \c T with SIMD instructions, the number of values
+     * in a batch and the alignment required by aligned loads and stores.
+     * When no instruction set is available for \c T, the batch type is
+     * \c T itself and the size of a batch is 1.
+     *
+     * @tparam T the scalar type
+     */
+    template <class T>
+    struct xsimd_traits
+    {
+        using batch_type = T;
+        static constexpr std::size_t size = 1;
+        static constexpr std::size_t alignment = alignof(T);
+    };
+
+    template <class T>
+    using xsimd_batch_t = typename xsimd_traits<T>::batch_type;
+
+    template <class T>
+    struct has_simd : std::integral_constant<bool, (xsimd_traits<T>::size > 1)>
+    {
+    };
+
+    template <class T, std::size_t N>
+    class xbatch;
+
+    template <class T, std::size_t N>
+    class xbatch_bool;
+
+    void stream_fence() noexcept;
+
+    /**********************
+     * has_simd_interface *
+     **********************/
+
+    /**
+     * Expressions providing the batch interface (load_batch, and store_batch
+     * for the assignable ones) declare a static boolean member \c simd_interface.
+     */
+    template <class E, class = void>
+    struct has_simd_interface : std::false_type
+    {
+    };
+
+    template <class E>
+    struct has_simd_interface<E, typename enable_if_type<decltype(std::decay_t<E>::simd_interface)>::type>
+        : std::integral_constant<bool, std::decay_t<E>::simd_interface>
+    {
+    };
+
+    /*************************
+     * batch alignment modes *
+     *************************/
+
+    /**
+     * Tags passed to load_batch and store_batch. With aligned_mode, the caller
+     * guarantees that the index of the batch is a multiple of the batch size:
+     * expressions whose data is aligned for batches (see container_alignment)
+     * then use aligned loads and stores. unaligned_mode, the default, makes no
+     * assumption on the index.
+     */
+    struct aligned_mode
+    {
+    };
+
+    struct unaligned_mode
+    {
+    };
+
+    namespace detail
+    {
+        template <class B, class Mode, std::size_t Align>
+        using use_aligned_batch = std::integral_constant<bool, std::is_same<Mode, aligned_mode>::value &&
+                                                                   Align >= xsimd_traits<typename B::value_type>::alignment>;
+
+        template <class B, class T>
+        inline B load_batch_impl(const T* src, std::true_type) noexcept
+        {
+            return B::load_aligned(src);
+        }
+
+        template <class B, class T>
+        inline B load_batch_impl(const T* src, std::false_type) noexcept
+        {
+            return B::load_unaligned(src);
+        }
+
+        template <class B, class T>
+        inline void store_batch_impl(T* dst, const B& batch, std::true_type) noexcept
+        {
+            batch.store_aligned(dst);
+        }
+
+        template <class B, class T>
+        inline void store_batch_impl(T* dst, const B& batch, std::false_type) noexcept
+        {
+            batch.store_unaligned(dst);
+        }
+
+        // Loads and stores a batch at the address src / dst of a buffer
+        // aligned on Align bytes; the alignment of the instruction is
+        // chosen at compile time.
+        template <class B, class Mode, std::size_t Align, class T>
+        inline B load_simd(const T* src) noexcept
+        {
+            return load_batch_impl<B>(src, use_aligned_batch<B, Mode, Align>());
+        }
+
+        template <class Mode, std::size_t Align, class B, class T>
+        inline void store_simd(T* dst, const B& batch) noexcept
+        {
+            store_batch_impl(dst, batch, use_aligned_batch<B, Mode, Align>());
+        }
+    }
+
+    template <class V, class F, class... Args>
+    struct has_simd_apply_impl : std::false_type
+    {
+    };
+
+    template <class F, class... Args>
+    struct has_simd_apply_impl<typename enable_if_type<decltype(std::declval<const F&>().simd_apply(std::declval<const Args&>()...))>::type, F, Args...>
+        : std::true_type
+    {
+    };
+
+    /**
+     * Checks whether the functor \c F provides a \c simd_apply method
+     * accepting arguments of types \c Args.
+     */
+    template <class F, class... Args>
+    using has_simd_apply = has_simd_apply_impl<void, F, Args...>;
+
+    /***********************
+     * lane-wise functions *
+     ***********************/
+
+    template <class F, class T, std::size_t N>
+    xbatch<T, N> apply_lanes(F&& f, const xbatch<T, N>& a);
+
+    template <class F, class T, std::size_t N>
+    xbatch<T, N> apply_lanes(F&& f, const xbatch<T, N>& a, const xbatch<T, N>& b);
+
+    template <class F, class T, std::size_t N>
+    xbatch<T, N> apply_lanes(F&& f, const xbatch<T, N>& a, const xbatch<T, N>& b, const xbatch<T, N>& c);
+
+    template <class T, std::size_t N>
+    T hadd(const xbatch<T, N>& a);
+
+    template <class T, std::size_t N>
+    T hmax(const xbatch<T, N>& a);
+
+    template <class T, std::size_t N>
+    T hmin(const xbatch<T, N>& a);
+
+#if defined(XTENSOR_SIMD_AVX) || defined(XTENSOR_SIMD_SSE2)
+
+    /**********
+     * xbatch *
+     **********/
+
+#define XTENSOR_BATCH_CLASS(T, N, REG, P, S)                                                    \
+    template <>                                                                                 \
+    class xbatch_bool<T, N>                                                                     \
+    {                                                                                           \
+    public:                                                                                     \
+                                                                                                \
+        using value_type = bool;                                                                \
+        using register_type = REG;                                                              \
+        static constexpr std::size_t size = N;                                                  \
+                                                                                                \
+        xbatch_bool() = default;                                                                \
+        xbatch_bool(register_type r) noexcept : m_value(r) {}                                   \
+                                                                                                \
+        operator register_type() const noexcept { return m_value; }                             \
+                                                                                                \
+        int mask() const noexcept { return P##movemask_##S(m_value); }                          \
+                                                                                                \
+    private:                                                                                    \
+                                                                                                \
+        register_type m_value;                                                                  \
+    };                                                                                          \
+                                                                                                \
+    template <>                                                                                 \
+    class xbatch<T, N>                                                                          \
+    {                                                                                           \
+    public:                                                                                     \
+                                                                                                \
+        using value_type = T;                                                                   \
+        using register_type = REG;                                                              \
+        using batch_bool_type = xbatch_bool<T, N>;                                              \
+        static constexpr std::size_t size = N;                                                  \
+                                                                                                \
+        xbatch() = default;                                                                     \
+        explicit xbatch(T v) noexcept : m_value(P##set1_##S(v)) {}                              \
+        xbatch(register_type r) noexcept : m_value(r) {}                                        \
+                                                                                                \
+        operator register_type() const noexcept { return m_value; }                             \
+                                                                                                \
+        static xbatch load_aligned(const T* src) noexcept { return P##load_##S(src); }          \
+        static xbatch load_unaligned(const T* src) noexcept { return P##loadu_##S(src); }       \
+        void store_aligned(T* dst) const noexcept { P##store_##S(dst, m_value); }               \
+        void store_unaligned(T* dst) const noexcept { P##storeu_##S(dst, m_value); }            \
+        void store_stream(T* dst) const noexcept { P##stream_##S(dst, m_value); }               \
+                                                                                                \
+        T operator[](std::size_t i) const noexcept                                              \
+        {                                                                                       \
+            T buffer[N];                                                                        \
+            store_unaligned(buffer);                                                            \
+            return buffer[i];                                                                   \
+        }                                                                                       \
+                                                                                                \
+        xbatch& operator+=(const xbatch& rhs) noexcept                                          \
+        {                                                                                       \
+            m_value = P##add_##S(m_value, rhs.m_value);                                         \
+            return *this;                                                                       \
+        }                                                                                       \
+        xbatch& operator-=(const xbatch& rhs) noexcept                                          \
+        {                                                                                       \
+            m_value = P##sub_##S(m_value, rhs.m_value);                                         \
+            return *this;                                                                       \
+        }                                                                                       \
+        xbatch& operator*=(const xbatch& rhs) noexcept                                          \
+        {                                                                                       \
+            m_value = P##mul_##S(m_value, rhs.m_value);                                         \
+            return *this;                                                                       \
+        }                                                                                       \
+        xbatch& operator/=(const xbatch& rhs) noexcept                                          \
+        {                                                                                       \
+            m_value = P##div_##S(m_value, rhs.m_value);                                         \
+            return *this;                                                                       \
+        }                                                                                       \
+                                                                                                \
+    private:                                                                                    \
+                                                                                                \
+        register_type m_value;                                                                  \
+    };                                                                                          \
+                                                                                                \
+    inline xbatch<T, N> operator+(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept        \
+    {                                                                                           \
+        return P##add_##S(a, b);                                                                \
+    }                                                                                           \
+    inline xbatch<T, N> operator-(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept        \
+    {                                                                                           \
+        return P##sub_##S(a, b);                                                                \
+    }                                                                                           \
+    inline xbatch<T, N> operator*(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept        \
+    {                                                                                           \
+        return P##mul_##S(a, b);                                                                \
+    }                                                                                           \
+    inline xbatch<T, N> operator/(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept        \
+    {                                                                                           \
+        return P##div_##S(a, b);                                                                \
+    }                                                                                           \
+    inline xbatch<T, N> operator+(const xbatch<T, N>& a) noexcept                               \
+    {                                                                                           \
+        return a;                                                                               \
+    }                                                                                           \
+    inline xbatch<T, N> operator-(const xbatch<T, N>& a) noexcept                               \
+    {                                                                                           \
+        return P##xor_##S(a, P##set1_##S(T(-0.)));                                              \
+    }                                                                                           \
+    inline xbatch<T, N> min(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept              \
+    {                                                                                           \
+        return P##min_##S(a, b);                                                                \
+    }                                                                                           \
+    inline xbatch<T, N> max(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept              \
+    {                                                                                           \
+        return P##max_##S(a, b);                                                                \
+    }                                                                                           \
+    inline xbatch<T, N> abs(const xbatch<T, N>& a) noexcept                                     \
+    {                                                                                           \
+        return P##andnot_##S(P##set1_##S(T(-0.)), a);                                           \
+    }                                                                                           \
+    inline xbatch<T, N> fabs(const xbatch<T, N>& a) noexcept                                    \
+    {                                                                                           \
+        return abs(a);                                                                          \
+    }                                                                                           \
+    inline xbatch<T, N> sqrt(const xbatch<T, N>& a) noexcept                                    \
+    {                                                                                           \
+        return P##sqrt_##S(a);                                                                  \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator&(const xbatch_bool<T, N>& a,                              \
+                                       const xbatch_bool<T, N>& b) noexcept                     \
+    {                                                                                           \
+        return P##and_##S(a, b);                                                                \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator|(const xbatch_bool<T, N>& a,                              \
+                                       const xbatch_bool<T, N>& b) noexcept                     \
+    {                                                                                           \
+        return P##or_##S(a, b);                                                                 \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator~(const xbatch_bool<T, N>& a) noexcept                     \
+    {                                                                                           \
+        using register_type = typename xbatch_bool<T, N>::register_type;                        \
+        register_type r = a;                                                                    \
+        return P##xor_##S(r, P##allbits_##S##_impl());                                          \
+    }                                                                                           \
+    inline bool any(const xbatch_bool<T, N>& a) noexcept                                        \
+    {                                                                                           \
+        return a.mask() != 0;                                                                   \
+    }                                                                                           \
+    inline bool all(const xbatch_bool<T, N>& a) noexcept                                        \
+    {                                                                                           \
+        return a.mask() == (1 << N) - 1;                                                        \
+    }                                                                                           \
+    inline xbatch<T, N> select(const xbatch_bool<T, N>& cond,                                   \
+                               const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept           \
+    {                                                                                           \
+        return P##or_##S(P##and_##S(cond, a), P##andnot_##S(cond, b));                          \
+    }                                                                                           \
+    inline xbatch<T, N> fmin(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept             \
+    {                                                                                           \
+        return select(isnan(a), b, P##min_##S(b, a));                                           \
+    }                                                                                           \
+    inline xbatch<T, N> fmax(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept             \
+    {                                                                                           \
+        return select(isnan(a), b, P##max_##S(b, a));                                           \
+    }
+
+#define XTENSOR_BATCH_COMPARISONS(T, N, CMP)                                                    \
+    inline xbatch_bool<T, N> operator<(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept   \
+    {                                                                                           \
+        return CMP(a, b, lt, _CMP_LT_OQ);                                                       \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator<=(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept  \
+    {                                                                                           \
+        return CMP(a, b, le, _CMP_LE_OQ);                                                       \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator>(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept   \
+    {                                                                                           \
+        return CMP(b, a, lt, _CMP_LT_OQ);                                                       \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator>=(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept  \
+    {                                                                                           \
+        return CMP(b, a, le, _CMP_LE_OQ);                                                       \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator==(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept  \
+    {                                                                                           \
+        return CMP(a, b, eq, _CMP_EQ_OQ);                                                       \
+    }                                                                                           \
+    inline xbatch_bool<T, N> operator!=(const xbatch<T, N>& a, const xbatch<T, N>& b) noexcept  \
+    {                                                                                           \
+        return CMP(a, b, neq, _CMP_NEQ_UQ);                                                     \
+    }                                                                                           \
+    inline xbatch_bool<T, N> isnan(const xbatch<T, N>& a) noexcept                              \
+    {                                                                                           \
+        return CMP(a, a, unord, _CMP_UNORD_Q);                                                  \
+    }
+
+#if defined(XTENSOR_SIMD_AVX)
+
+#define XTENSOR_AVX_CMP_PD(a, b, SSE_OP, AVX_OP) _mm256_cmp_pd(a, b, AVX_OP)
+#define XTENSOR_AVX_CMP_PS(a, b, SSE_OP, AVX_OP) _mm256_cmp_ps(a, b, AVX_OP)
+#define _mm256_allbits_pd_impl() _mm256_castsi256_pd(_mm256_set1_epi32(-1))
+#define _mm256_allbits_ps_impl() _mm256_castsi256_ps(_mm256_set1_epi32(-1))
+
+    template <>
+    struct xsimd_traits<double>
+    {
+        using batch_type = xbatch<double, 4>;
+        static constexpr std::size_t size = 4;
+        static constexpr std::size_t alignment = 32;
+    };
+
+    template <>
+    struct xsimd_traits<float>
+    {
+        using batch_type = xbatch<float, 8>;
+        static constexpr std::size_t size = 8;
+        static constexpr std::size_t alignment = 32;
+    };
+
+    inline xbatch_bool<double, 4> isnan(const xbatch<double, 4>& a) noexcept;
+    inline xbatch_bool<float, 8> isnan(const xbatch<float, 8>& a) noexcept;
+
+    XTENSOR_BATCH_CLASS(double, 4, __m256d, _mm256_, pd)
+    XTENSOR_BATCH_CLASS(float, 8, __m256, _mm256_, ps)
+    XTENSOR_BATCH_COMPARISONS(double, 4, XTENSOR_AVX_CMP_PD)
+    XTENSOR_BATCH_COMPARISONS(float, 8, XTENSOR_AVX_CMP_PS)
+
+#undef _mm256_allbits_ps_impl
+#undef _mm256_allbits_pd_impl
+#undef XTENSOR_AVX_CMP_PS
+#undef XTENSOR_AVX_CMP_PD
+
+#if defined(__FMA__)
+    inline xbatch<double, 4> fma(const xbatch<double, 4>& a, const xbatch<double, 4>& b,
+                                 const xbatch<double, 4>& c) noexcept
+    {
+        return _mm256_fmadd_pd(a, b, c);
+    }
+
+    inline xbatch<float, 8> fma(const xbatch<float, 8>& a, const xbatch<float, 8>& b,
+                                const xbatch<float, 8>& c) noexcept
+    {
+        return _mm256_fmadd_ps(a, b, c);
+    }
+#define XTENSOR_SIMD_FMA
+#endif
+
+#else
+
+#define XTENSOR_SSE_CMP_PD(a, b, SSE_OP, AVX_OP) _mm_cmp##SSE_OP##_pd(a, b)
+#define XTENSOR_SSE_CMP_PS(a, b, SSE_OP, AVX_OP) _mm_cmp##SSE_OP##_ps(a, b)
+#define _mm_allbits_pd_impl() _mm_castsi128_pd(_mm_set1_epi32(-1))
+#define _mm_allbits_ps_impl() _mm_castsi128_ps(_mm_set1_epi32(-1))
+
+    template <>
+    struct xsimd_traits<double>
+    {
+        using batch_type = xbatch<double, 2>;
+        static constexpr std::size_t size = 2;
+        static constexpr std::size_t alignment = 16;
+    };
+
+    template <>
+    struct xsimd_traits<float>
+    {
+        using batch_type = xbatch<float, 4>;
+        static constexpr std::size_t size = 4;
+        static constexpr std::size_t alignment = 16;
+    };
+
+    inline xbatch_bool<double, 2> isnan(const xbatch<double, 2>& a) noexcept;
+    inline xbatch_bool<float, 4> isnan(const xbatch<float, 4>& a) noexcept;
+
+    XTENSOR_BATCH_CLASS(double, 2, __m128d, _mm_, pd)
+    XTENSOR_BATCH_CLASS(float, 4, __m128, _mm_, ps)
+    XTENSOR_BATCH_COMPARISONS(double, 2, XTENSOR_SSE_CMP_PD)
+    XTENSOR_BATCH_COMPARISONS(float, 4, XTENSOR_SSE_CMP_PS)
+
+#undef _mm_allbits_ps_impl
+#undef _mm_allbits_pd_impl
+#undef XTENSOR_SSE_CMP_PS
+#undef XTENSOR_SSE_CMP_PD
+
+#endif
+
+#undef XTENSOR_BATCH_COMPARISONS
+#undef XTENSOR_BATCH_CLASS
+
+#endif
+
+    /**
+     * Orders the non-temporal stores (see xbatch::store_stream) issued by
+     * the calling thread before the stores that follow it.
+     */
+    inline void stream_fence() noexcept
+    {
+#if defined(XTENSOR_SIMD_AVX) || defined(XTENSOR_SIMD_SSE2)
+        _mm_sfence();
+#endif
+    }
+
+    /**************************************
+     * lane-wise functions implementation *
+     **************************************/
+
+    /**
+     * Applies the scalar function \c f to each value of the batch \c a.
+     * This is the fallback for functions without SIMD instruction.
+     */
+    template <class F, class T, std::size_t N>
+    inline xbatch<T, N> apply_lanes(F&& f, const xbatch<T, N>& a)
+    {
+        T va[N];
+        a.store_unaligned(va);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            va[i] = f(va[i]);
+        }
+        return xbatch<T, N>::load_unaligned(va);
+    }
+
+    template <class F, class T, std::size_t N>
+    inline xbatch<T, N> apply_lanes(F&& f, const xbatch<T, N>& a, const xbatch<T, N>& b)
+    {
+        T va[N], vb[N];
+        a.store_unaligned(va);
+        b.store_unaligned(vb);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            va[i] = f(va[i], vb[i]);
+        }
+        return xbatch<T, N>::load_unaligned(va);
+    }
+
+    template <class F, class T, std::size_t N>
+    inline xbatch<T, N> apply_lanes(F&& f, const xbatch<T, N>& a, const xbatch<T, N>& b, const xbatch<T, N>& c)
+    {
+        T va[N], vb[N], vc[N];
+        a.store_unaligned(va);
+        b.store_unaligned(vb);
+        c.store_unaligned(vc);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            va[i] = f(va[i], vb[i], vc[i]);
+        }
+        return xbatch<T, N>::load_unaligned(va);
+    }
+
+    /**
+     * Returns the sum of the values of the batch, accumulated from the
+     * first one to the last one.
+     */
+    template <class T, std::size_t N>
+    inline T hadd(const xbatch<T, N>& a)
+    {
+        T va[N];
+        a.store_unaligned(va);
+        T res = va[0];
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            res += va[i];
+        }
+        return res;
+    }
+
+    /**
+     * Returns the maximum of the values of the batch.
+     */
+    template <class T, std::size_t N>
+    inline T hmax(const xbatch<T, N>& a)
+    {
+        T va[N];
+        a.store_unaligned(va);
+        T res = va[0];
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            res = va[i] > res ? va[i] : res;
+        }
+        return res;
+    }
+
+    /**
+     * Returns the minimum of the values of the batch.
+     */
+    template <class T, std::size_t N>
+    inline T hmin(const xbatch<T, N>& a)
+    {
+        T va[N];
+        a.store_unaligned(va);
+        T res = va[0];
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            res = va[i] < res ? va[i] : res;
+        }
+        return res;
+    }
+
+#define XTENSOR_LANEWISE_UNARY(NAME)                                              \
+    template <class T, std::size_t N>                                             \
+    inline xbatch<T, N> NAME(const xbatch<T, N>& a)                               \
+    {                                                                             \
+        return apply_lanes([](const T& x) { using std::NAME; return NAME(x); }, a); \
+    }
+
+#define XTENSOR_LANEWISE_BINARY(NAME)                                                           \
+    template <class T, std::size_t N>                                                           \
+    inline xbatch<T, N> NAME(const xbatch<T, N>& a, const xbatch<T, N>& b)                      \
+    {                                                                                           \
+        return apply_lanes([](const T& x, const T& y) { using std::NAME; return NAME(x, y); }, a, b); \
+    }
+
+    XTENSOR_LANEWISE_BINARY(fmod)
+    XTENSOR_LANEWISE_BINARY(remainder)
+    XTENSOR_LANEWISE_BINARY(fdim)
+    XTENSOR_LANEWISE_UNARY(exp)
+    XTENSOR_LANEWISE_UNARY(exp2)
+    XTENSOR_LANEWISE_UNARY(expm1)
+    XTENSOR_LANEWISE_UNARY(log)
+    XTENSOR_LANEWISE_UNARY(log10)
+    XTENSOR_LANEWISE_UNARY(log2)
+    XTENSOR_LANEWISE_UNARY(log1p)
+    XTENSOR_LANEWISE_BINARY(pow)
+    XTENSOR_LANEWISE_UNARY(cbrt)
+    XTENSOR_LANEWISE_BINARY(hypot)
+    XTENSOR_LANEWISE_UNARY(sin)
+    XTENSOR_LANEWISE_UNARY(cos)
+    XTENSOR_LANEWISE_UNARY(tan)
+    XTENSOR_LANEWISE_UNARY(asin)
+    XTENSOR_LANEWISE_UNARY(acos)
+    XTENSOR_LANEWISE_UNARY(atan)
+    XTENSOR_LANEWISE_BINARY(atan2)
+    XTENSOR_LANEWISE_UNARY(sinh)
+    XTENSOR_LANEWISE_UNARY(cosh)
+    XTENSOR_LANEWISE_UNARY(tanh)
+    XTENSOR_LANEWISE_UNARY(asinh)
+    XTENSOR_LANEWISE_UNARY(acosh)
+    XTENSOR_LANEWISE_UNARY(atanh)
+    XTENSOR_LANEWISE_UNARY(erf)
+    XTENSOR_LANEWISE_UNARY(erfc)
+    XTENSOR_LANEWISE_UNARY(tgamma)
+    XTENSOR_LANEWISE_UNARY(lgamma)
+    XTENSOR_LANEWISE_UNARY(ceil)
+    XTENSOR_LANEWISE_UNARY(floor)
+    XTENSOR_LANEWISE_UNARY(trunc)
+    XTENSOR_LANEWISE_UNARY(round)
+    XTENSOR_LANEWISE_UNARY(nearbyint)
+    XTENSOR_LANEWISE_UNARY(rint)
+
+#undef XTENSOR_LANEWISE_BINARY
+#undef XTENSOR_LANEWISE_UNARY
+
+#if !defined(XTENSOR_SIMD_FMA)
+    template <class T, std::size_t N>
+    inline xbatch<T, N> fma(const xbatch<T, N>& a, const xbatch<T, N>& b, const xbatch<T, N>& c)
+    {
+        return apply_lanes([](const T& x, const T& y, const T& z) { return std::fma(x, y, z); }, a, b, c);
+    }
+#endif
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "xbatch.hpp"
 #include "xexpression.hpp"
 #include "xiterable.hpp"
 #include "xstrides.hpp"
@@ -94,8 +95,8 @@ namespace xt
         using const_stepper = typename iterable_base::const_stepper;
 
         static constexpr layout_type static_layout = xexpression_type::static_layout;
-        //static constexpr bool contiguous_layout = xexpression_type::contiguous_layout;
-        static constexpr bool contiguous_layout = false;
+        static constexpr bool contiguous_layout = xexpression_type::contiguous_layout;
+        static constexpr bool simd_interface = has_simd_interface<xexpression_type>::value;
 
         template <class CTA, class S>
         xbroadcast(CTA&& e, S&& s) noexcept;
@@ -119,15 +120,30 @@ namespace xt
         template <class S>
         bool is_trivial_broadcast(const S& strides) const noexcept;
 
+        template <class F>
+        bool visit_strides(F&& f) const;
+
+        template <class F>
+        bool visit_memory(F&& f) const;
+
+        template <class F>
+        void visit_stages(F&& f) const;
+
         template <class S>
         const_stepper stepper_begin(const S& shape) const noexcept;
         template <class S>
         const_stepper stepper_end(const S& shape, layout_type l) const noexcept;
 
+        const_reference data_element(size_type i) const;
+
+        template <class B, class Mode = unaligned_mode>
+        B load_batch(size_type i) const;
+
     private:
 
         CT m_e;
         inner_shape_type m_shape;
+        bool m_trivial_broadcast;
     };
 
     /****************************
@@ -188,9 +204,9 @@ namespace xt
     template <class CT, class X>
     template <class CTA, class S>
     inline xbroadcast<CT, X>::xbroadcast(CTA&& e, S&& s) noexcept
-        : m_e(std::forward<CTA>(e)), m_shape(std::forward<S>(s))
+        : m_e(std::forward<CTA>(e)), m_shape(std::forward<S>(s)), m_trivial_broadcast(false)
     {
-        xt::broadcast_shape(m_e.shape(), m_shape);
+        m_trivial_broadcast = xt::broadcast_shape(m_e.shape(), m_shape);
     }
     //@}
 
@@ -308,9 +324,42 @@ namespace xt
     template <class S>
     inline bool xbroadcast<CT, X>::is_trivial_broadcast(const S& strides) const noexcept
     {
-        return dimension() == m_e.dimension() &&
-            std::equal(m_shape.cbegin(), m_shape.cend(), m_e.shape().cbegin()) &&
-            m_e.is_trivial_broadcast(strides);
+        return m_trivial_broadcast && m_e.is_trivial_broadcast(strides);
+    }
+
+    /**
+     * Calls \c f with the strides of the broadcast expression.
+     * @return false if the strides of the expression are unknown
+     * @sa visit_strides
+     */
+    template <class CT, class X>
+    template <class F>
+    inline bool xbroadcast<CT, X>::visit_strides(F&& f) const
+    {
+        return xt::visit_strides(m_e, f);
+    }
+
+    /**
+     * Calls \c f with the range of memory of the broadcast expression.
+     * @return false if the memory of the expression is unknown
+     * @sa visit_memory
+     */
+    template <class CT, class X>
+    template <class F>
+    inline bool xbroadcast<CT, X>::visit_memory(F&& f) const
+    {
+        return xt::visit_memory(m_e, f);
+    }
+
+    /**
+     * Calls \c f with the staged subexpressions of the broadcast expression.
+     * @sa visit_stages
+     */
+    template <class CT, class X>
+    template <class F>
+    inline void xbroadcast<CT, X>::visit_stages(F&& f) const
+    {
+        xt::visit_stages(m_e, f);
     }
     //@}
 
@@ -329,6 +378,21 @@ namespace xt
         // Could check if (broadcastable(shape, m_shape)
         return m_e.stepper_end(shape, l);
     }
+
+    // data_element and load_batch are only meaningful when the broadcasting
+    // is trivial, i.e. when the shape is the one of the underlying expression.
+    template <class CT, class X>
+    inline auto xbroadcast<CT, X>::data_element(size_type i) const -> const_reference
+    {
+        return m_e.data_element(i);
+    }
+
+    template <class CT, class X>
+    template <class B, class Mode>
+    inline B xbroadcast<CT, X>::load_batch(size_type i) const
+    {
+        return m_e.template load_batch<B, Mode>(i);
+    }
 }
 
 #endif
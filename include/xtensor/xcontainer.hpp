@@ -14,6 +14,7 @@
 #include <numeric>
 #include <stdexcept>
 
+#include "xbatch.hpp"
 #include "xiterable.hpp"
 #include "xiterator.hpp"
 #include "xmath.hpp"
@@ -76,6 +77,8 @@ namespace xt
 
         static constexpr layout_type static_layout = inner_types::layout;
         static constexpr bool contiguous_layout = static_layout != layout_type::dynamic;
+        static constexpr bool simd_interface = has_simd<value_type>::value;
+        static constexpr std::size_t data_alignment = container_alignment<container_type>::value;
 
         size_type size() const noexcept;
 
@@ -114,6 +117,12 @@ namespace xt
         template <class S>
         bool is_trivial_broadcast(const S& strides) const noexcept;
 
+        template <class F>
+        bool visit_strides(F&& f) const;
+
+        template <class F>
+        bool visit_memory(F&& f) const;
+
         template <class S>
         stepper stepper_begin(const S& shape) noexcept;
         template <class S>
@@ -127,6 +136,10 @@ namespace xt
         reference data_element(size_type i);
         const_reference data_element(size_type i) const;
 
+        template <class B, class Mode = unaligned_mode>
+        B load_batch(size_type i) const;
+        template <class B, class Mode = unaligned_mode>
+        void store_batch(size_type i, const B& batch);
 
         template <layout_type L>
         using layout_iterator = typename iterable_base::template layout_iterator<L>;
@@ -627,6 +640,33 @@ namespace xt
         return str.size() == strides().size() &&
             std::equal(str.cbegin(), str.cend(), strides().begin());
     }
+
+    /**
+     * Calls \c f with the strides of the container.
+     * @return true, the strides of a container are always known
+     * @sa visit_strides
+     */
+    template <class D>
+    template <class F>
+    inline bool xcontainer<D>::visit_strides(F&& f) const
+    {
+        f(strides());
+        return true;
+    }
+
+    /**
+     * Calls \c f with the range of memory of the container.
+     * @return true, the memory of a container is always known
+     * @sa visit_memory
+     */
+    template <class D>
+    template <class F>
+    inline bool xcontainer<D>::visit_memory(F&& f) const
+    {
+        const value_type* first = raw_data();
+        f(static_cast<const void*>(first), static_cast<const void*>(first + data().size()));
+        return true;
+    }
     //@}
 
     /****************
@@ -1013,6 +1053,35 @@ namespace xt
         return data()[i];
     }
 
+    /**
+     * Loads the batch of values starting at index \c i in the underlying
+     * container.
+     * @tparam B the batch type, see xsimd_traits
+     * @tparam Mode aligned_mode if \c i is a multiple of the batch size,
+     * in which case an aligned load is used if data_alignment allows it.
+     * @param i the index of the first value of the batch
+     */
+    template <class D>
+    template <class B, class Mode>
+    inline B xcontainer<D>::load_batch(size_type i) const
+    {
+        return detail::load_simd<B, Mode, data_alignment>(raw_data() + i);
+    }
+
+    /**
+     * Stores the batch \c batch at index \c i in the underlying container.
+     * @tparam Mode aligned_mode if \c i is a multiple of the batch size,
+     * in which case an aligned store is used if data_alignment allows it.
+     * @param i the index of the first value of the batch
+     * @param batch the values to store
+     */
+    template <class D>
+    template <class B, class Mode>
+    inline void xcontainer<D>::store_batch(size_type i, const B& batch)
+    {
+        detail::store_simd<Mode, data_alignment>(raw_data() + i, batch);
+    }
+
     /*************************************
      * xstrided_container implementation *
      *************************************/
@@ -17,10 +17,12 @@
 #include <type_traits>
 #include <utility>
 
+#include "xbatch.hpp"
 #include "xexpression.hpp"
 #include "xiterable.hpp"
 #include "xlayout.hpp"
 #include "xscalar.hpp"
+#include "xstrides.hpp"
 #include "xutils.hpp"
 
 namespace xt
@@ -79,6 +81,30 @@ namespace xt
 
         template <class... Args>
         using common_value_type_t = typename common_value_type<Args...>::type;
+
+        /*******************
+         * is_simd_operand *
+         *******************/
+
+        // An operand can feed a batch of type xsimd_batch_t<R> if it provides
+        // the batch interface for R; scalars are converted when loaded.
+        template <class R, class E>
+        struct is_simd_operand
+        {
+            static constexpr bool value = has_simd_interface<E>::value &&
+                (std::is_same<typename E::value_type, R>::value || is_xscalar<E>::value);
+        };
+
+        template <class T, class E>
+        using batch_for_t = xsimd_batch_t<T>;
+
+        template <class F, class R, class... E>
+        struct is_simd_function
+        {
+            static constexpr bool value = has_simd<R>::value &&
+                and_c<is_simd_operand<R, E>::value...>::value &&
+                has_simd_apply<F, batch_for_t<R, E>...>::value;
+        };
     }
 
     template <class F, class R, class... CT>
@@ -141,6 +167,7 @@ namespace xt
 
         static constexpr layout_type static_layout = compute_layout(std::decay_t<CT>::static_layout...);
         static constexpr bool contiguous_layout = and_c<std::decay_t<CT>::contiguous_layout...>::value;
+        static constexpr bool simd_interface = detail::is_simd_function<functor_type, R, std::decay_t<CT>...>::value;
 
         template <layout_type L>
         using layout_iterator = typename iterable_base::template layout_iterator<L>;
@@ -193,6 +220,17 @@ namespace xt
         template <class S>
         bool is_trivial_broadcast(const S& strides) const noexcept;
 
+        bool has_trivial_broadcast() const;
+
+        template <class Func>
+        bool visit_strides(Func&& f) const;
+
+        template <class Func>
+        bool visit_memory(Func&& f) const;
+
+        template <class Func>
+        void visit_stages(Func&& f) const;
+
         using iterable_base::begin;
         using iterable_base::end;
         using iterable_base::cbegin;
@@ -227,6 +265,9 @@ namespace xt
 
         const_reference data_element(size_type i) const;
 
+        template <class B, class Mode = unaligned_mode>
+        B load_batch(size_type i) const;
+
     private:
 
         template <std::size_t... I>
@@ -241,6 +282,12 @@ namespace xt
         template <std::size_t... I>
         const_reference data_element_impl(std::index_sequence<I...>, size_type i) const;
 
+        template <class B, class Mode, std::size_t... I>
+        B load_batch_impl(std::index_sequence<I...>, size_type i) const;
+
+        template <class Func, std::size_t... I>
+        void visit_stages_impl(Func& f, std::index_sequence<I...>) const;
+
         template <class Func, std::size_t... I>
         const_stepper build_stepper(Func&& f, std::index_sequence<I...>) const noexcept;
 
@@ -249,10 +296,23 @@ namespace xt
 
         size_type compute_dimension() const noexcept;
 
+        template <class S, std::size_t... I>
+        bool broadcast_arguments(S& shape, std::index_sequence<I...>) const;
+
         std::tuple<CT...> m_e;
         functor_type m_f;
+        // A single member holds the state of the cached shape: adding
+        // members to xfunction prevents the compiler from keeping small
+        // temporary functions in registers.
+        enum class shape_state
+        {
+            uncomputed,
+            broadcast,
+            trivial_broadcast
+        };
+
         mutable shape_type m_shape;
-        mutable bool m_shape_computed;
+        mutable shape_state m_shape_state;
 
         friend class xfunction_iterator<F, R, CT...>;
         friend class xfunction_stepper<F, R, CT...>;
@@ -414,7 +474,7 @@ namespace xt
     template <class Func>
     inline xfunction<F, R, CT...>::xfunction(Func&& f, CT... e) noexcept
         : m_e(e...), m_f(std::forward<Func>(f)), m_shape(make_sequence<shape_type>(0, size_type(1))),
-          m_shape_computed(false)
+          m_shape_state(shape_state::uncomputed)
     {
     }
     //@}
@@ -438,21 +498,23 @@ namespace xt
     template <class F, class R, class... CT>
     inline auto xfunction<F, R, CT...>::dimension() const noexcept -> size_type
     {
-        size_type dimension = m_shape_computed ? m_shape.size() : compute_dimension();
+        size_type dimension = m_shape_state != shape_state::uncomputed ? m_shape.size() : compute_dimension();
         return dimension;
     }
 
     /**
-     * Returns the shape of the xfunction.
+     * Returns the shape of the xfunction. The shape is computed from the
+     * arguments on the first call, together with the flag returned by
+     * has_trivial_broadcast.
      */
     template <class F, class R, class... CT>
     inline auto xfunction<F, R, CT...>::shape() const -> const shape_type&
     {
-        if (!m_shape_computed)
+        if (m_shape_state == shape_state::uncomputed)
         {
             m_shape = make_sequence<shape_type>(compute_dimension(), size_type(1));
-            broadcast_shape(m_shape);
-            m_shape_computed = true;
+            bool trivial_broadcast = broadcast_arguments(m_shape, std::make_index_sequence<sizeof...(CT)>());
+            m_shape_state = trivial_broadcast ? shape_state::trivial_broadcast : shape_state::broadcast;
         }
         return m_shape;
     }
@@ -523,9 +585,15 @@ namespace xt
     template <class S>
     inline bool xfunction<F, R, CT...>::broadcast_shape(S& shape) const
     {
-        // e.broadcast_shape must be evaluated even if b is false
-        auto func = [&shape](bool b, auto&& e) { return e.broadcast_shape(shape) && b; };
-        return accumulate(func, true, m_e);
+        if (m_shape_state != shape_state::uncomputed)
+        {
+            // The broadcasting of the arguments is trivial if and only if they all
+            // have the shape of the function, and this shape is the result shape.
+            bool trivial_broadcast = xt::broadcast_shape(m_shape, shape);
+            return trivial_broadcast && m_shape_state == shape_state::trivial_broadcast;
+        }
+        // Temporary subexpressions are not worth caching
+        return broadcast_arguments(shape, std::make_index_sequence<sizeof...(CT)>());
     }
 
     /**
@@ -537,9 +605,62 @@ namespace xt
     template <class S>
     inline bool xfunction<F, R, CT...>::is_trivial_broadcast(const S& strides) const noexcept
     {
+        if (m_shape_state == shape_state::broadcast)
+        {
+            return false;
+        }
         auto func = [&strides](bool b, auto&& e) { return b && e.is_trivial_broadcast(strides); };
         return accumulate(func, true, m_e);
     }
+
+    /**
+     * Checks whether all the arguments of the function have its shape, i.e.
+     * whether broadcasting the function to its own shape is trivial. The
+     * result is computed with the shape and cached.
+     */
+    template <class F, class R, class... CT>
+    inline bool xfunction<F, R, CT...>::has_trivial_broadcast() const
+    {
+        shape();
+        return m_shape_state == shape_state::trivial_broadcast;
+    }
+
+    /**
+     * Calls \c f with the strides of each argument of the function.
+     * @return false if the strides of an argument are unknown
+     * @sa visit_strides
+     */
+    template <class F, class R, class... CT>
+    template <class Func>
+    inline bool xfunction<F, R, CT...>::visit_strides(Func&& f) const
+    {
+        auto func = [&f](bool b, auto&& e) { return b && xt::visit_strides(e, f); };
+        return accumulate(func, true, m_e);
+    }
+
+    /**
+     * Calls \c f with the range of memory of each argument of the function.
+     * @return false if the memory of an argument is unknown
+     * @sa visit_memory
+     */
+    template <class F, class R, class... CT>
+    template <class Func>
+    inline bool xfunction<F, R, CT...>::visit_memory(Func&& f) const
+    {
+        auto func = [&f](bool b, auto&& e) { return b && xt::visit_memory(e, f); };
+        return accumulate(func, true, m_e);
+    }
+
+    /**
+     * Calls \c f with the staged subexpressions of each argument of the function.
+     * @sa visit_stages
+     */
+    template <class F, class R, class... CT>
+    template <class Func>
+    inline void xfunction<F, R, CT...>::visit_stages(Func&& f) const
+    {
+        visit_stages_impl(f, std::make_index_sequence<sizeof...(CT)>());
+    }
     //@}
 
     template <class F, class R, class... CT>
@@ -622,6 +743,20 @@ namespace xt
         return data_element_impl(std::make_index_sequence<sizeof...(CT)>(), i);
     }
 
+    /**
+     * Returns the batch of values of the function starting at index \c i.
+     * This is only available when simd_interface is true.
+     * @tparam B the batch type, see xsimd_traits
+     * @tparam Mode the alignment mode forwarded to the operands
+     * @param i the index of the first value of the batch
+     */
+    template <class F, class R, class... CT>
+    template <class B, class Mode>
+    inline B xfunction<F, R, CT...>::load_batch(size_type i) const
+    {
+        return load_batch_impl<B, Mode>(std::make_index_sequence<sizeof...(CT)>(), i);
+    }
+
     template <class F, class R, class... CT>
     template <std::size_t... I>
     inline layout_type xfunction<F, R, CT...>::layout_impl(std::index_sequence<I...>) const noexcept
@@ -650,6 +785,22 @@ namespace xt
         return m_f((std::get<I>(m_e).data_element(i))...);
     }
 
+    template <class F, class R, class... CT>
+    template <class B, class Mode, std::size_t... I>
+    inline B xfunction<F, R, CT...>::load_batch_impl(std::index_sequence<I...>, size_type i) const
+    {
+        return m_f.simd_apply((std::get<I>(m_e).template load_batch<B, Mode>(i))...);
+    }
+
+    template <class F, class R, class... CT>
+    template <class Func, std::size_t... I>
+    inline void xfunction<F, R, CT...>::visit_stages_impl(Func& f, std::index_sequence<I...>) const
+    {
+        // The elements of a braced list are evaluated in order
+        int visited[] = {0, (xt::visit_stages(std::get<I>(m_e), f), 0)...};
+        (void)visited;
+    }
+
     template <class F, class R, class... CT>
     template <class Func, std::size_t... I>
     inline auto xfunction<F, R, CT...>::build_stepper(Func&& f, std::index_sequence<I...>) const noexcept -> const_stepper
@@ -671,6 +822,18 @@ namespace xt
         return accumulate(func, size_type(0), m_e);
     }
 
+    template <class F, class R, class... CT>
+    template <class S, std::size_t... I>
+    inline bool xfunction<F, R, CT...>::broadcast_arguments(S& shape, std::index_sequence<I...>) const
+    {
+        // Every argument must be broadcast, even after a non-trivial one;
+        // the elements of a braced list are evaluated in order.
+        bool trivial_broadcast = true;
+        int broadcast[] = {(trivial_broadcast = std::get<I>(m_e).broadcast_shape(shape) && trivial_broadcast, 0)...};
+        (void)broadcast;
+        return trivial_broadcast;
+    }
+
     /*************************************
      * xfunction_iterator implementation *
      *************************************/
@@ -0,0 +1,483 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XHISTOGRAM_HPP
+#define XHISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xarray.hpp"
+#include "xexpression.hpp"
+#include "xmath.hpp"
+#include "xparallel.hpp"
+#include "xstorage.hpp"
+#include "xstrides.hpp"
+#include "xtensor.hpp"
+
+namespace xt
+{
+
+    /***********************
+     * histogram functions *
+     ***********************/
+
+    template <class E>
+    auto bincount(const xexpression<E>& data, std::size_t minlength = 0);
+
+    template <class E1, class E2>
+    auto bincount(const xexpression<E1>& data, const xexpression<E2>& weights, std::size_t minlength = 0);
+
+    template <class E>
+    auto histogram(const xexpression<E>& data, std::size_t bins, double left, double right);
+
+    template <class E>
+    auto histogram(const xexpression<E>& data, std::size_t bins = 10);
+
+    template <class E1, class E2>
+    auto histogram(const xexpression<E1>& data, const xexpression<E2>& edges);
+
+    template <class E>
+    auto histogram(const xexpression<E>& data, std::size_t bins, double left, double right, std::size_t axis);
+
+    template <class E>
+    auto histogram_bin_edges(const xexpression<E>& data, std::size_t bins = 10);
+
+    /**************************************
+     * histogram functions implementation *
+     **************************************/
+
+    namespace detail
+    {
+        // Bins of equal width over [left, right]. The bin found from the
+        // width is corrected against the edges so that the values falling
+        // on an edge are counted as with explicit edges. Values out of the
+        // range are mapped to the invalid bin n.
+        struct uniform_bins
+        {
+            double left;
+            double right;
+            double width;
+            std::size_t n;
+
+            uniform_bins(double l, double r, std::size_t nb_bins)
+                : left(l), right(r), width((r - l) / double(nb_bins)), n(nb_bins)
+            {
+            }
+
+            double edge(std::size_t i) const noexcept
+            {
+                return left + double(i) * width;
+            }
+
+            template <class T>
+            std::size_t operator()(const T& value) const noexcept
+            {
+                double v = double(value);
+                if (!(v >= left && v <= right))
+                {
+                    return n;
+                }
+                std::size_t i = std::min(std::size_t((v - left) / width), n - 1);
+                if (v < edge(i))
+                {
+                    --i;
+                }
+                else if (i + 1 < n && v >= edge(i + 1))
+                {
+                    ++i;
+                }
+                return i;
+            }
+        };
+
+        // Bins delimited by sorted edges, found by binary search. The last
+        // bin includes its right edge.
+        template <class T>
+        struct edge_bins
+        {
+            const T* first;
+            const T* last;
+
+            template <class V>
+            std::size_t operator()(const V& v) const noexcept
+            {
+                std::size_t n = std::size_t(last - first) - 1;
+                if (!(v >= *first && v <= *(last - 1)))
+                {
+                    return n;
+                }
+                std::size_t i = std::size_t(std::upper_bound(first, last, v) - first);
+                return std::min(i, n) - 1;
+            }
+        };
+
+        struct integral_bins
+        {
+            template <class V>
+            std::size_t operator()(const V& v) const noexcept
+            {
+                return std::size_t(v);
+            }
+        };
+
+        // Adds weight(i) to the bin of value(i) for each i in [first, last).
+        // The bins are computed by blocks before being incremented, so that
+        // the computation of uniform bins can be vectorized.
+        template <class C, class B, class V, class W>
+        inline void count_range(C* counts, std::size_t nb_bins, const B& bin, const V& value, const W& weight,
+                                std::size_t first, std::size_t last)
+        {
+            constexpr std::size_t block_size = 256;
+            std::size_t index[block_size];
+            for (std::size_t i = first; i < last; i += block_size)
+            {
+                std::size_t n = std::min(block_size, last - i);
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                    index[k] = bin(value(i + k));
+                }
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                    if (index[k] < nb_bins)
+                    {
+                        counts[index[k]] += weight(i + k);
+                    }
+                }
+            }
+        }
+
+        // Counts the values of [0, size) into nb_bins bins. Each chunk of
+        // values is counted into private bins, which are summed in chunk
+        // order at the end. Floating point weights are counted by a single
+        // chunk when deterministic reductions are enabled.
+        template <class C, class B, class V, class W>
+        inline uvector<C> count_bins(std::size_t size, std::size_t nb_bins, const B& bin, const V& value, const W& weight)
+        {
+            bool serial = std::is_floating_point<C>::value && deterministic_reductions();
+            std::size_t nb_chunks = serial ? 1 : parallel_chunk_count(size, XTENSOR_PARALLEL_GRAIN_SIZE);
+            std::vector<uvector<C>> partial(nb_chunks, uvector<C>(nb_bins, C(0)));
+            parallel_for_each_chunk(nb_chunks, [&](std::size_t c) {
+                count_range(partial[c].data(), nb_bins, bin, value, weight, size * c / nb_chunks, size * (c + 1) / nb_chunks);
+            });
+            for (std::size_t c = 1; c < nb_chunks; ++c)
+            {
+                for (std::size_t b = 0; b < nb_bins; ++b)
+                {
+                    partial[0][b] += partial[c][b];
+                }
+            }
+            return std::move(partial[0]);
+        }
+
+        template <class C>
+        inline xtensor<C, 1> make_counts(uvector<C>&& counts)
+        {
+            xtensor<C, 1> res = xtensor<C, 1>::from_shape({counts.size()});
+            std::copy(counts.cbegin(), counts.cend(), res.data().begin());
+            return res;
+        }
+
+        template <class E, class B>
+        inline xtensor<std::size_t, 1> histogram_impl(const E& e, std::size_t nb_bins, const B& bin)
+        {
+            auto value = [&e](std::size_t i) { return e.data_element(i); };
+            auto one = [](std::size_t) { return std::size_t(1); };
+            return make_counts(count_bins<std::size_t>(e.size(), nb_bins, bin, value, one));
+        }
+
+        // Counts the elements of e, which are accessed linearly, either
+        // directly or after an evaluation in row-major order.
+        template <class E, class B>
+        inline xtensor<std::size_t, 1> histogram_linear(const E& e, std::size_t nb_bins, const B& bin)
+        {
+            return dispatch_linear(e, [nb_bins, &bin](const auto& d, layout_type) {
+                return histogram_impl(d, nb_bins, bin);
+            }, [nb_bins, &bin](const auto& d) {
+                xarray<typename E::value_type, layout_type::row_major> values = d;
+                return histogram_impl(values, nb_bins, bin);
+            });
+        }
+
+        template <class E>
+        inline std::pair<double, double> histogram_range(const E& e)
+        {
+            if (e.size() == 0)
+            {
+                return std::make_pair(0., 1.);
+            }
+            double left = double(amin(e)());
+            double right = double(amax(e)());
+            if (left == right)
+            {
+                left -= 0.5;
+                right += 0.5;
+            }
+            return std::make_pair(left, right);
+        }
+
+        inline void check_histogram_range(std::size_t bins, double left, double right)
+        {
+            if (bins == 0)
+            {
+                throw std::runtime_error("Histogram requires at least one bin");
+            }
+            if (!(left < right))
+            {
+                throw std::runtime_error("Histogram range must be increasing");
+            }
+        }
+
+        template <class E>
+        inline void check_bincount_values(const E& e, std::true_type /*signed*/)
+        {
+            if (amin(e)() < 0)
+            {
+                throw std::runtime_error("bincount requires non-negative values");
+            }
+        }
+
+        template <class E>
+        inline void check_bincount_values(const E&, std::false_type /*signed*/)
+        {
+        }
+
+        template <class E>
+        inline std::size_t bincount_size(const E& e, std::size_t minlength)
+        {
+            if (e.size() == 0)
+            {
+                return minlength;
+            }
+            check_bincount_values(e, std::is_signed<typename E::value_type>());
+            return std::max(std::size_t(amax(e)()) + 1, minlength);
+        }
+    }
+
+    /**
+     * @defgroup histogram_functions Histogram functions
+     */
+
+    /**
+     * @ingroup histogram_functions
+     * @brief Counts the occurrences of each value of \em data.
+     *
+     * The element \c i of the result is the number of elements of \em data
+     * equal to \c i. The values are counted in parallel, each thread
+     * having private counts that are summed at the end.
+     * @param data an \ref xexpression of non-negative integers
+     * @param minlength the minimal number of bins
+     * @return a 1-D xtensor of max(max(data) + 1, minlength) elements
+     */
+    template <class E>
+    inline auto bincount(const xexpression<E>& data, std::size_t minlength)
+    {
+        using value_type = typename E::value_type;
+        static_assert(std::is_integral<value_type>::value, "bincount requires integral values");
+        const E& de = data.derived_cast();
+        std::size_t nb_bins = detail::bincount_size(de, minlength);
+        return detail::histogram_linear(de, nb_bins, detail::integral_bins());
+    }
+
+    /**
+     * @ingroup histogram_functions
+     * @brief Sums the weights of the occurrences of each value of \em data.
+     *
+     * The element \c i of the result is the sum of the elements of
+     * \em weights at the positions where \em data is equal to \c i.
+     * @param data an \ref xexpression of non-negative integers
+     * @param weights an \ref xexpression with the same shape as \em data
+     * @param minlength the minimal number of bins
+     */
+    template <class E1, class E2>
+    inline auto bincount(const xexpression<E1>& data, const xexpression<E2>& weights, std::size_t minlength)
+    {
+        using value_type = typename E1::value_type;
+        using weight_type = typename E2::value_type;
+        static_assert(std::is_integral<value_type>::value, "bincount requires integral values");
+        const E1& de = data.derived_cast();
+        const E2& dw = weights.derived_cast();
+        if (de.dimension() != dw.dimension() || !std::equal(de.shape().cbegin(), de.shape().cend(), dw.shape().cbegin()))
+        {
+            throw std::runtime_error("bincount requires weights with the same shape as data");
+        }
+        std::size_t nb_bins = detail::bincount_size(de, minlength);
+        auto count = [nb_bins](const auto& d, const auto& w) {
+            auto value = [&d](std::size_t i) { return d.data_element(i); };
+            auto weight = [&w](std::size_t i) { return w.data_element(i); };
+            return detail::make_counts(detail::count_bins<weight_type>(d.size(), nb_bins, detail::integral_bins(), value, weight));
+        };
+        auto evaluated = [&count, &de, &dw](const auto&) {
+            xarray<value_type, layout_type::row_major> d = de;
+            xarray<weight_type, layout_type::row_major> w = dw;
+            return count(d, w);
+        };
+        return dispatch_linear(de, [&count, &dw, &evaluated](const auto& d, layout_type l) {
+            return dispatch_linear(dw, [&count, &d, &evaluated, l](const auto& w, layout_type lw) {
+                return l == lw ? count(d, w) : evaluated(w);
+            }, evaluated);
+        }, evaluated);
+    }
+
+    /**
+     * @ingroup histogram_functions
+     * @brief Computes the histogram of \em data with bins of equal width.
+     *
+     * The range [\em left, \em right] is divided into \em bins bins of equal
+     * width. Each bin includes its left edge, the last one also includes
+     * \em right. The values out of the range are ignored. The values are
+     * counted in parallel, each thread having private counts that are
+     * summed at the end.
+     * @param data an \ref xexpression
+     * @param bins the number of bins
+     * @param left the lower bound of the range
+     * @param right the upper bound of the range
+     * @return a 1-D xtensor holding the number of elements in each bin
+     */
+    template <class E>
+    inline auto histogram(const xexpression<E>& data, std::size_t bins, double left, double right)
+    {
+        detail::check_histogram_range(bins, left, right);
+        return detail::histogram_linear(data.derived_cast(), bins, detail::uniform_bins(left, right, bins));
+    }
+
+    /**
+     * @ingroup histogram_functions
+     * @brief Computes the histogram of \em data with bins of equal width
+     * over the range of its values.
+     * @param data an \ref xexpression
+     * @param bins the number of bins
+     * @sa histogram_bin_edges
+     */
+    template <class E>
+    inline auto histogram(const xexpression<E>& data, std::size_t bins)
+    {
+        auto range = detail::histogram_range(data.derived_cast());
+        return histogram(data, bins, range.first, range.second);
+    }
+
+    /**
+     * @ingroup histogram_functions
+     * @brief Computes the histogram of \em data with the given bin edges.
+     *
+     * Bin \c i holds the values in [edges[i], edges[i + 1]), the last bin
+     * also includes its right edge. The bin of each value is found by
+     * binary search.
+     * @param data an \ref xexpression
+     * @param edges a 1-D \ref xexpression of increasing edges
+     */
+    template <class E1, class E2>
+    inline auto histogram(const xexpression<E1>& data, const xexpression<E2>& edges)
+    {
+        using edge_type = typename E2::value_type;
+        uvector<edge_type> e(edges.derived_cast().size());
+        std::copy(edges.derived_cast().cbegin(), edges.derived_cast().cend(), e.begin());
+        if (e.size() < 2 || !std::is_sorted(e.cbegin(), e.cend()))
+        {
+            throw std::runtime_error("Histogram edges must be increasing");
+        }
+        detail::edge_bins<edge_type> bin = {e.data(), e.data() + e.size()};
+        return detail::histogram_linear(data.derived_cast(), e.size() - 1, bin);
+    }
+
+    /**
+     * @ingroup histogram_functions
+     * @brief Computes a histogram of \em data for each line along \em axis.
+     *
+     * The histograms are computed in parallel across lines.
+     * @param data an \ref xexpression
+     * @param bins the number of bins
+     * @param left the lower bound of the range
+     * @param right the upper bound of the range
+     * @param axis the axis along which the histograms are computed
+     * @return an xarray whose shape is the shape of \em data without
+     * \em axis, followed by \em bins
+     */
+    template <class E>
+    inline auto histogram(const xexpression<E>& data, std::size_t bins, double left, double right, std::size_t axis)
+    {
+        using value_type = typename E::value_type;
+        const E& de = data.derived_cast();
+        if (axis >= de.dimension())
+        {
+            throw std::out_of_range("Histogram axis out of bounds");
+        }
+        detail::check_histogram_range(bins, left, right);
+
+        using result_type = xarray<std::size_t, layout_type::row_major>;
+        typename result_type::shape_type shape;
+        resize_container(shape, de.dimension());
+        std::copy(de.shape().cbegin(), de.shape().cbegin() + std::ptrdiff_t(axis), shape.begin());
+        std::copy(de.shape().cbegin() + std::ptrdiff_t(axis) + 1, de.shape().cend(), shape.begin() + std::ptrdiff_t(axis));
+        shape.back() = bins;
+        result_type res = result_type::from_shape(shape);
+        std::fill(res.data().begin(), res.data().end(), std::size_t(0));
+        if (de.size() == 0)
+        {
+            return res;
+        }
+
+        auto count = [&res, bins, left, right, axis](const auto& d) {
+            detail::line_geometry g = detail::make_line_geometry(d.shape(), axis, layout_type::row_major);
+            detail::uniform_bins bin(left, right, bins);
+            std::size_t* out = &res.data_element(0);
+            std::size_t grain = std::max(XTENSOR_PARALLEL_GRAIN_SIZE / g.n, std::size_t(1));
+            parallel_for(g.size(), grain, [&d, &bin, &g, out, bins](std::size_t first, std::size_t last) {
+                for (std::size_t l = first; l < last; ++l)
+                {
+                    std::size_t offset = g.line_offset(l);
+                    auto value = [&d, &g, offset](std::size_t k) { return d.data_element(offset + k * g.inner); };
+                    auto one = [](std::size_t) { return std::size_t(1); };
+                    detail::count_range(out + l * bins, bins, bin, value, one, 0, g.n);
+                }
+            });
+        };
+        auto evaluated = [&count](const auto& d) {
+            xarray<value_type, layout_type::row_major> values = d;
+            count(values);
+        };
+        dispatch_linear(de, [&count, &evaluated](const auto& d, layout_type l) {
+            if (l == layout_type::row_major)
+            {
+                count(d);
+            }
+            else
+            {
+                evaluated(d);
+            }
+        }, evaluated);
+        return res;
+    }
+
+    /**
+     * @ingroup histogram_functions
+     * @brief Returns the edges of the bins used by histogram(data, bins).
+     * @param data an \ref xexpression
+     * @param bins the number of bins
+     * @return a 1-D xtensor of bins + 1 increasing edges
+     */
+    template <class E>
+    inline auto histogram_bin_edges(const xexpression<E>& data, std::size_t bins)
+    {
+        auto range = detail::histogram_range(data.derived_cast());
+        detail::uniform_bins b(range.first, range.second, bins);
+        xtensor<double, 1> res = xtensor<double, 1>::from_shape({bins + 1});
+        for (std::size_t i = 0; i < bins; ++i)
+        {
+            res(i) = b.edge(i);
+        }
+        res(bins) = range.second;
+        return res;
+    }
+}
+
+#endif
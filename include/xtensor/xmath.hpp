@@ -13,8 +13,12 @@
 #ifndef XMATH_HPP
 #define XMATH_HPP
 
+#include <array>
 #include <cmath>
 #include <complex>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
 #include <type_traits>
 
 #include "xoperation.hpp"
@@ -62,6 +66,12 @@ namespace xt
             using std::NAME;                       \
             return NAME(arg);                      \
         }                                          \
+        template <class B>                         \
+        B simd_apply(const B& arg) const           \
+        {                                          \
+            using std::NAME;                       \
+            return NAME(arg);                      \
+        }                                          \
     }
 
 #define UNARY_MATH_FUNCTOR_COMPLEX_REDUCING(NAME)            \
@@ -75,6 +85,12 @@ namespace xt
             using std::NAME;                                 \
             return NAME(arg);                                \
         }                                                    \
+        template <class B>                                   \
+        B simd_apply(const B& arg) const                     \
+        {                                                    \
+            using std::NAME;                                 \
+            return NAME(arg);                                \
+        }                                                    \
     }
 
 #define BINARY_MATH_FUNCTOR(NAME)                                  \
@@ -89,6 +105,12 @@ namespace xt
             using std::NAME;                                       \
             return NAME(arg1, arg2);                               \
         }                                                          \
+        template <class B>                                         \
+        B simd_apply(const B& arg1, const B& arg2) const           \
+        {                                                          \
+            using std::NAME;                                       \
+            return NAME(arg1, arg2);                               \
+        }                                                          \
     }
 
 #define TERNARY_MATH_FUNCTOR(NAME)                                                \
@@ -104,6 +126,12 @@ namespace xt
             using std::NAME;                                                      \
             return NAME(arg1, arg2, arg3);                                        \
         }                                                                         \
+        template <class B>                                                        \
+        B simd_apply(const B& arg1, const B& arg2, const B& arg3) const           \
+        {                                                                         \
+            using std::NAME;                                                      \
+            return NAME(arg1, arg2, arg3);                                        \
+        }                                                                         \
     }
 
 #define UNARY_BOOL_FUNCTOR(NAME)                                                    \
@@ -334,6 +362,12 @@ namespace xt
             {
                 return (t1 < t2) ? t1 : t2;
             }
+
+            template <class B>
+            B simd_apply(const B& b1, const B& b2) const noexcept
+            {
+                return min(b1, b2);
+            }
         };
 
         template <class T>
@@ -345,6 +379,12 @@ namespace xt
             {
                 return (t1 > t2) ? t1 : t2;
             }
+
+            template <class B>
+            B simd_apply(const B& b1, const B& b2) const noexcept
+            {
+                return max(b1, b2);
+            }
         };
 
         template <class T>
@@ -1311,40 +1351,59 @@ namespace xt
      *
      * Returns an \ref xreducer for the sum of elements over given
      * \em axes.
+     * @tparam S the summation algorithm, naive by default
      * @param e an \ref xexpression
      * @param axes the axes along which the sum is performed (optional)
      * @return an \ref xreducer
      */
-    template <class E, class X>
+    template <summation S = summation::naive, class E, class X>
     inline auto sum(E&& e, X&& axes) noexcept
     {
-        using functor_type = std::plus<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::summation_plus<typename std::decay_t<E>::value_type, S>;
         return reduce(functor_type(), std::forward<E>(e), std::forward<X>(axes));
     }
 
-    template <class E>
+    template <summation S = summation::naive, class E>
     inline auto sum(E&& e) noexcept
     {
-        using functor_type = std::plus<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::summation_plus<typename std::decay_t<E>::value_type, S>;
         return reduce(functor_type(), std::forward<E>(e));
     }
 
 #ifdef X_OLD_CLANG
-    template <class E, class I>
+    template <summation S = summation::naive, class E, class I>
     inline auto sum(E&& e, std::initializer_list<I> axes) noexcept
     {
-        using functor_type = std::plus<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::summation_plus<typename std::decay_t<E>::value_type, S>;
         return reduce(functor_type(), std::forward<E>(e), axes);
     }
 #else
-    template <class E, class I, std::size_t N>
+    template <summation S = summation::naive, class E, class I, std::size_t N>
     inline auto sum(E&& e, const I (&axes)[N]) noexcept
     {
-        using functor_type = std::plus<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::summation_plus<typename std::decay_t<E>::value_type, S>;
         return reduce(functor_type(), std::forward<E>(e), axes);
     }
 #endif
 
+    /**
+     * @ingroup red_functions
+     * @brief Sum of elements over axes known at compile time.
+     *
+     * Returns an \ref xreducer for the sum of elements over the axes
+     * given as template arguments, in increasing order.
+     * @tparam I the first axis
+     * @tparam J the following axes
+     * @param e an \ref xexpression
+     * @return an \ref xreducer
+     * @sa xaxes
+     */
+    template <std::size_t I, std::size_t... J, class E>
+    inline auto sum(E&& e) noexcept
+    {
+        return sum(std::forward<E>(e), xaxes<I, J...>());
+    }
+
     /**
      * @ingroup red_functions
      * @brief Product of elements over given axes.
@@ -1358,14 +1417,14 @@ namespace xt
     template <class E, class X>
     inline auto prod(E&& e, X&& axes) noexcept
     {
-        using functor_type = std::multiplies<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::multiplies<typename std::decay_t<E>::value_type>;
         return reduce(functor_type(), std::forward<E>(e), std::forward<X>(axes));
     }
 
     template <class E>
     inline auto prod(E&& e) noexcept
     {
-        using functor_type = std::multiplies<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::multiplies<typename std::decay_t<E>::value_type>;
         return reduce(functor_type(), std::forward<E>(e));
     }
 
@@ -1373,14 +1432,14 @@ namespace xt
     template <class E, class I>
     inline auto prod(E&& e, std::initializer_list<I> axes) noexcept
     {
-        using functor_type = std::multiplies<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::multiplies<typename std::decay_t<E>::value_type>;
         return reduce(functor_type(), std::forward<E>(e), axes);
     }
 #else
     template <class E, class I, std::size_t N>
     inline auto prod(E&& e, const I (&axes)[N]) noexcept
     {
-        using functor_type = std::multiplies<typename std::decay_t<E>::value_type>;
+        using functor_type = detail::multiplies<typename std::decay_t<E>::value_type>;
         return reduce(functor_type(), std::forward<E>(e), axes);
     }
 #endif
@@ -1391,46 +1450,677 @@ namespace xt
      *
      * Returns an \ref xreducer for the mean of elements over given
      * \em axes.
+     * @tparam S the summation algorithm, naive by default
      * @param e an \ref xexpression
      * @param axes the axes along which the mean is computed (optional)
      * @return an \ref xexpression
      */
-    template <class E, class X>
+    template <summation S = summation::naive, class E, class X>
     inline auto mean(E&& e, X&& axes) noexcept
     {
         using value_type = typename std::decay_t<E>::value_type;
         auto size = e.size();
-        auto s = sum(std::forward<E>(e), std::forward<X>(axes));
+        auto s = sum<S>(std::forward<E>(e), std::forward<X>(axes));
         return std::move(s) / value_type(size / s.size());
     }
 
-    template <class E>
+    template <summation S = summation::naive, class E>
     inline auto mean(E&& e) noexcept
     {
         using value_type = typename std::decay_t<E>::value_type;
         auto size = e.size();
-        return sum(std::forward<E>(e)) / value_type(size);
+        return sum<S>(std::forward<E>(e)) / value_type(size);
     }
 
 #ifdef X_OLD_CLANG
-    template <class E, class I>
+    template <summation S = summation::naive, class E, class I>
     inline auto mean(E&& e, std::initializer_list<I> axes) noexcept
     {
         using value_type = typename std::decay_t<E>::value_type;
         auto size = e.size();
-        auto s = sum(std::forward<E>(e), axes);
+        auto s = sum<S>(std::forward<E>(e), axes);
         return std::move(s) / value_type(size / s.size());
     }
 #else
-    template <class E, class I, std::size_t N>
+    template <summation S = summation::naive, class E, class I, std::size_t N>
     inline auto mean(E&& e, const I (&axes)[N]) noexcept
     {
         using value_type = typename std::decay_t<E>::value_type;
         auto size = e.size();
-        auto s = sum(std::forward<E>(e), axes);
+        auto s = sum<S>(std::forward<E>(e), axes);
         return std::move(s) / value_type(size / s.size());
     }
 #endif
+
+    /**
+     * @ingroup red_functions
+     * @brief Mean of elements over axes known at compile time.
+     *
+     * Returns an \ref xexpression for the mean of elements over the axes
+     * given as template arguments, in increasing order.
+     * @tparam I the first axis
+     * @tparam J the following axes
+     * @param e an \ref xexpression
+     * @return an \ref xexpression
+     * @sa xaxes
+     */
+    template <std::size_t I, std::size_t... J, class E>
+    inline auto mean(E&& e) noexcept
+    {
+        return mean(std::forward<E>(e), xaxes<I, J...>());
+    }
+
+    namespace detail
+    {
+        template <class T>
+        struct nonzero_counter
+        {
+            std::size_t operator()(std::size_t count, const T& value) const
+            {
+                return count + std::size_t(value != T(0));
+            }
+        };
+
+        template <class T>
+        using norm_value_type_t = std::decay_t<decltype(std::abs(std::declval<T>()))>;
+
+        // Type of the norms computed with roots or ratios, which must not
+        // be truncated: integral absolute values are promoted to double.
+        template <class T>
+        using norm_real_type_t = std::conditional_t<std::is_integral<norm_value_type_t<T>>::value, double, norm_value_type_t<T>>;
+
+        template <class T>
+        struct abs_accumulator
+        {
+            using result_type = norm_value_type_t<T>;
+
+            result_type operator()(const result_type& acc, const T& value) const
+            {
+                using std::abs;
+                return acc + abs(value);
+            }
+
+            template <class B>
+            B simd_apply(const B& acc, const B& values) const
+            {
+                return acc + abs(values);
+            }
+        };
+
+        template <class T>
+        struct squared_abs_accumulator
+        {
+            using result_type = norm_value_type_t<T>;
+
+            result_type operator()(const result_type& acc, const T& value) const
+            {
+                using std::abs;
+                result_type a = abs(value);
+                return acc + a * a;
+            }
+
+            // Only used for real values, whose squared absolute value is
+            // their square.
+            template <class B>
+            B simd_apply(const B& acc, const B& values) const
+            {
+                return acc + values * values;
+            }
+        };
+
+        template <class T>
+        struct max_abs_accumulator
+        {
+            using result_type = norm_value_type_t<T>;
+
+            result_type operator()(const result_type& acc, const T& value) const
+            {
+                using std::abs;
+                result_type a = abs(value);
+                return a > acc ? a : acc;
+            }
+
+            template <class B>
+            B simd_apply(const B& acc, const B& values) const
+            {
+                return max(abs(values), acc);
+            }
+        };
+
+        template <class T>
+        class lp_accumulator
+        {
+        public:
+
+            using result_type = norm_real_type_t<T>;
+
+            explicit lp_accumulator(double p)
+                : m_p(p)
+            {
+            }
+
+            result_type operator()(const result_type& acc, const T& value) const
+            {
+                using std::abs;
+                return acc + result_type(std::pow(result_type(abs(value)), m_p));
+            }
+
+        private:
+
+            double m_p;
+        };
+
+        /**
+         * Sum of squares scaled by the largest absolute value met so far,
+         * so that neither overflows nor underflows: the L2 norm is
+         * <tt>scale * sqrt(ssq)</tt>.
+         */
+        template <class T>
+        struct scaled_ssq
+        {
+            T scale;
+            T ssq;
+        };
+
+        template <class T>
+        struct scaled_ssq_accumulator
+        {
+            using value_type = norm_real_type_t<T>;
+            using result_type = scaled_ssq<value_type>;
+
+            result_type operator()(const result_type& acc, const T& value) const
+            {
+                using std::abs;
+                value_type a = value_type(abs(value));
+                if (a == value_type(0))
+                {
+                    return acc;
+                }
+                if (acc.scale < a)
+                {
+                    value_type r = acc.scale / a;
+                    return result_type{a, value_type(1) + acc.ssq * r * r};
+                }
+                value_type r = a / acc.scale;
+                return result_type{acc.scale, acc.ssq + r * r};
+            }
+
+            result_type operator()(const result_type& lhs, const result_type& rhs) const
+            {
+                if (lhs.scale < rhs.scale)
+                {
+                    return (*this)(rhs, lhs);
+                }
+                if (rhs.scale == value_type(0))
+                {
+                    return lhs;
+                }
+                value_type r = rhs.scale / lhs.scale;
+                return result_type{lhs.scale, lhs.ssq + rhs.ssq * r * r};
+            }
+        };
+
+        template <class A>
+        struct scaled_norm
+        {
+            using argument_type = A;
+            using result_type = decltype(std::declval<A>().scale);
+
+            result_type operator()(const A& arg) const
+            {
+                using std::sqrt;
+                return arg.scale * sqrt(arg.ssq);
+            }
+        };
+
+        template <class T>
+        inline auto make_count_nonzero_functor()
+        {
+            return make_xreducer_functor(nonzero_counter<T>(), const_value<std::size_t>(0), plus<std::size_t>());
+        }
+
+        template <template <class> class A, class T>
+        inline auto make_norm_functor()
+        {
+            using result_type = norm_value_type_t<T>;
+            return make_xreducer_functor(A<T>(), const_value<result_type>(0), plus<result_type>());
+        }
+
+        template <class T>
+        inline auto make_norm_linf_functor()
+        {
+            using result_type = norm_value_type_t<T>;
+            return make_xreducer_functor(max_abs_accumulator<T>(), const_value<result_type>(0), math::maximum<result_type>());
+        }
+
+        template <class T>
+        inline auto make_norm_lp_functor(double p)
+        {
+            if (!(p > 0.))
+            {
+                throw std::invalid_argument("norm_lp requires p > 0");
+            }
+            using result_type = norm_real_type_t<T>;
+            return make_xreducer_functor(lp_accumulator<T>(p), const_value<result_type>(0), plus<result_type>());
+        }
+
+        template <class T>
+        inline auto make_scaled_ssq_functor()
+        {
+            using result_type = typename scaled_ssq_accumulator<T>::result_type;
+            using value_type = typename scaled_ssq_accumulator<T>::value_type;
+            return make_xreducer_functor(scaled_ssq_accumulator<T>(), const_value<result_type>(result_type{value_type(0), value_type(1)}));
+        }
+
+        /**
+         * Value and flat position of the extremum of a reduction; the index
+         * of an empty reduction is std::size_t(-1).
+         */
+        template <class T>
+        struct xarg_result
+        {
+            T value;
+            std::size_t index;
+        };
+
+        // Keeps the element preferred by C, or the first one in case of a
+        // tie, so that the result does not depend on the order of reduction.
+        template <class T, class C>
+        struct arg_extremum
+        {
+            using result_type = xarg_result<T>;
+
+            result_type operator()(const result_type& acc, const T& value, std::size_t index) const
+            {
+                return operator()(acc, result_type{value, index});
+            }
+
+            result_type operator()(const result_type& lhs, const result_type& rhs) const
+            {
+                C cmp;
+                if (lhs.index == std::size_t(-1))
+                {
+                    return rhs;
+                }
+                if (rhs.index == std::size_t(-1))
+                {
+                    return lhs;
+                }
+                bool take_rhs = cmp(rhs.value, lhs.value) || (!cmp(lhs.value, rhs.value) && rhs.index < lhs.index);
+                return take_rhs ? rhs : lhs;
+            }
+        };
+
+        template <class A>
+        struct arg_index
+        {
+            using argument_type = A;
+            using result_type = std::size_t;
+
+            std::size_t operator()(const A& arg) const
+            {
+                return arg.index;
+            }
+        };
+
+        template <class C, class T>
+        inline auto make_arg_functor()
+        {
+            using result_type = xarg_result<T>;
+            return make_xreducer_functor(arg_extremum<T, C>(), const_value<result_type>(result_type{T(), std::size_t(-1)}));
+        }
+    }
+
+    /**
+     * @ingroup red_functions
+     * @brief Number of non-zero elements over given axes.
+     *
+     * Returns an \ref xreducer for the number of elements different from 0
+     * over given \em axes, as std::size_t.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the elements are counted (optional)
+     * @return an \ref xreducer
+     */
+    template <class E, class X>
+    inline auto count_nonzero(E&& e, X&& axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_count_nonzero_functor<value_type>(), std::forward<E>(e), std::forward<X>(axes));
+    }
+
+    template <class E>
+    inline auto count_nonzero(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_count_nonzero_functor<value_type>(), std::forward<E>(e));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto count_nonzero(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_count_nonzero_functor<value_type>(), std::forward<E>(e), axes);
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto count_nonzero(E&& e, const I (&axes)[N]) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_count_nonzero_functor<value_type>(), std::forward<E>(e), axes);
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief L1 norm over given axes.
+     *
+     * Returns an \ref xreducer for the sum of the absolute values of the
+     * elements over given \em axes.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the norm is computed (optional)
+     * @return an \ref xreducer
+     */
+    template <class E, class X>
+    inline auto norm_l1(E&& e, X&& axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::abs_accumulator, value_type>(), std::forward<E>(e), std::forward<X>(axes));
+    }
+
+    template <class E>
+    inline auto norm_l1(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::abs_accumulator, value_type>(), std::forward<E>(e));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto norm_l1(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::abs_accumulator, value_type>(), std::forward<E>(e), axes);
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto norm_l1(E&& e, const I (&axes)[N]) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::abs_accumulator, value_type>(), std::forward<E>(e), axes);
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief Squared L2 norm over given axes.
+     *
+     * Returns an \ref xreducer for the sum of the squared absolute values
+     * of the elements over given \em axes.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the norm is computed (optional)
+     * @return an \ref xreducer
+     */
+    template <class E, class X>
+    inline auto norm_sq(E&& e, X&& axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e), std::forward<X>(axes));
+    }
+
+    template <class E>
+    inline auto norm_sq(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto norm_sq(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e), axes);
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto norm_sq(E&& e, const I (&axes)[N]) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e), axes);
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief L2 norm over given axes.
+     *
+     * Returns an \ref xexpression for the square root of the sum of the
+     * squared absolute values of the elements over given \em axes.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the norm is computed (optional)
+     * @return an \ref xexpression
+     */
+    template <class E, class X>
+    inline auto norm_l2(E&& e, X&& axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return sqrt(reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e), std::forward<X>(axes)));
+    }
+
+    template <class E>
+    inline auto norm_l2(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return sqrt(reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e)));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto norm_l2(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return sqrt(reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e), axes));
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto norm_l2(E&& e, const I (&axes)[N]) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return sqrt(reduce(detail::make_norm_functor<detail::squared_abs_accumulator, value_type>(), std::forward<E>(e), axes));
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief Infinity norm over given axes.
+     *
+     * Returns an \ref xreducer for the maximum of the absolute values of
+     * the elements over given \em axes, 0 for an empty reduction.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the norm is computed (optional)
+     * @return an \ref xreducer
+     */
+    template <class E, class X>
+    inline auto norm_linf(E&& e, X&& axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_linf_functor<value_type>(), std::forward<E>(e), std::forward<X>(axes));
+    }
+
+    template <class E>
+    inline auto norm_linf(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_linf_functor<value_type>(), std::forward<E>(e));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto norm_linf(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_linf_functor<value_type>(), std::forward<E>(e), axes);
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto norm_linf(E&& e, const I (&axes)[N]) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return reduce(detail::make_norm_linf_functor<value_type>(), std::forward<E>(e), axes);
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief Lp norm over given axes.
+     *
+     * Returns an \ref xexpression for the p-th root of the sum of the
+     * absolute values raised to the power \em p of the elements over the
+     * given \em axes. \ref norm_l1, \ref norm_l2 and \ref norm_linf are
+     * faster for the usual values of \em p.
+     * @param e an \ref xexpression
+     * @param p the order of the norm, strictly positive
+     * @param axes the axes along which the norm is computed (optional)
+     * @return an \ref xexpression, whose value type is double for
+     * integral expressions
+     * @throw std::invalid_argument if \em p is not strictly positive.
+     */
+    template <class E, class X>
+    inline auto norm_lp(E&& e, double p, X&& axes)
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        using result_type = detail::norm_real_type_t<value_type>;
+        return pow(reduce(detail::make_norm_lp_functor<value_type>(p), std::forward<E>(e), std::forward<X>(axes)), result_type(1. / p));
+    }
+
+    template <class E>
+    inline auto norm_lp(E&& e, double p)
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        using result_type = detail::norm_real_type_t<value_type>;
+        return pow(reduce(detail::make_norm_lp_functor<value_type>(p), std::forward<E>(e)), result_type(1. / p));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto norm_lp(E&& e, double p, std::initializer_list<I> axes)
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        using result_type = detail::norm_real_type_t<value_type>;
+        return pow(reduce(detail::make_norm_lp_functor<value_type>(p), std::forward<E>(e), axes), result_type(1. / p));
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto norm_lp(E&& e, double p, const I (&axes)[N])
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        using result_type = detail::norm_real_type_t<value_type>;
+        return pow(reduce(detail::make_norm_lp_functor<value_type>(p), std::forward<E>(e), axes), result_type(1. / p));
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief L2 norm over given axes, without intermediate overflow.
+     *
+     * Returns an \ref xexpression for the L2 norm of the elements over the
+     * given \em axes. Unlike \ref norm_l2, the squares are scaled by the
+     * largest absolute value, like in std::hypot, so that the result is
+     * accurate even when the squares of the elements overflow or underflow.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the norm is computed (optional)
+     * @return an \ref xexpression
+     */
+    template <class E, class X>
+    inline auto norm_l2_scaled(E&& e, X&& axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return detail::make_xfunction<detail::scaled_norm>(reduce(detail::make_scaled_ssq_functor<value_type>(), std::forward<E>(e), std::forward<X>(axes)));
+    }
+
+    template <class E>
+    inline auto norm_l2_scaled(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return detail::make_xfunction<detail::scaled_norm>(reduce(detail::make_scaled_ssq_functor<value_type>(), std::forward<E>(e)));
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto norm_l2_scaled(E&& e, std::initializer_list<I> axes) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return detail::make_xfunction<detail::scaled_norm>(reduce(detail::make_scaled_ssq_functor<value_type>(), std::forward<E>(e), axes));
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto norm_l2_scaled(E&& e, const I (&axes)[N]) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        return detail::make_xfunction<detail::scaled_norm>(reduce(detail::make_scaled_ssq_functor<value_type>(), std::forward<E>(e), axes));
+    }
+#endif
+
+    /**
+     * @ingroup red_functions
+     * @brief Position of the maximum element along a given axis.
+     *
+     * Returns an \ref xexpression for the index of the maximum element
+     * along the given \em axis, or in the flattened expression in row-major
+     * order when no axis is given. The first occurrence is returned in case
+     * of ties. The elements are read only once, in the order of the storage
+     * when the expression is contiguous.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the maximum is found (optional)
+     * @return an \ref xexpression of std::size_t
+     */
+    template <class E>
+    inline auto argmax(E&& e, std::size_t axis) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        using axes_type = std::array<typename std::decay_t<E>::size_type, 1>;
+        auto f = detail::make_arg_functor<std::greater<value_type>, value_type>();
+        return detail::make_xfunction<detail::arg_index>(reduce(std::move(f), std::forward<E>(e), axes_type({axis})));
+    }
+
+    template <class E>
+    inline auto argmax(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        auto f = detail::make_arg_functor<std::greater<value_type>, value_type>();
+        return detail::make_xfunction<detail::arg_index>(reduce(std::move(f), std::forward<E>(e)));
+    }
+
+    /**
+     * @ingroup red_functions
+     * @brief Position of the minimum element along a given axis.
+     *
+     * Returns an \ref xexpression for the index of the minimum element
+     * along the given \em axis, or in the flattened expression in row-major
+     * order when no axis is given. The first occurrence is returned in case
+     * of ties. The elements are read only once, in the order of the storage
+     * when the expression is contiguous.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the minimum is found (optional)
+     * @return an \ref xexpression of std::size_t
+     */
+    template <class E>
+    inline auto argmin(E&& e, std::size_t axis) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        using axes_type = std::array<typename std::decay_t<E>::size_type, 1>;
+        auto f = detail::make_arg_functor<std::less<value_type>, value_type>();
+        return detail::make_xfunction<detail::arg_index>(reduce(std::move(f), std::forward<E>(e), axes_type({axis})));
+    }
+
+    template <class E>
+    inline auto argmin(E&& e) noexcept
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        auto f = detail::make_arg_functor<std::less<value_type>, value_type>();
+        return detail::make_xfunction<detail::arg_index>(reduce(std::move(f), std::forward<E>(e)));
+    }
 }
 
 #endif
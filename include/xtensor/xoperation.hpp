@@ -10,10 +10,13 @@
 #define XOPERATION_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <type_traits>
 
 #include "xfunction.hpp"
+#include "xparallel.hpp"
 #include "xscalar.hpp"
 #include "xstrides.hpp"
 
@@ -36,8 +39,58 @@ namespace xt
             {
                 return +t;
             }
+
+            template <class B>
+            constexpr B simd_apply(const B& b) const noexcept
+            {
+                return b;
+            }
         };
 
+#define UNARY_OPERATOR_FUNCTOR(NAME, OP)                           \
+    template <class T>                                             \
+    struct NAME                                                    \
+    {                                                              \
+        using argument_type = T;                                   \
+        using result_type = T;                                     \
+        constexpr T operator()(const T& t) const noexcept          \
+        {                                                          \
+            return OP t;                                           \
+        }                                                          \
+        template <class B>                                         \
+        constexpr B simd_apply(const B& b) const noexcept          \
+        {                                                          \
+            return OP b;                                           \
+        }                                                          \
+    }
+
+#define BINARY_OPERATOR_FUNCTOR(NAME, OP)                                        \
+    template <class T>                                                           \
+    struct NAME                                                                  \
+    {                                                                            \
+        using first_argument_type = T;                                           \
+        using second_argument_type = T;                                          \
+        using result_type = T;                                                   \
+        constexpr T operator()(const T& t1, const T& t2) const noexcept          \
+        {                                                                        \
+            return t1 OP t2;                                                     \
+        }                                                                        \
+        template <class B>                                                       \
+        constexpr B simd_apply(const B& b1, const B& b2) const noexcept          \
+        {                                                                        \
+            return b1 OP b2;                                                     \
+        }                                                                        \
+    }
+
+        UNARY_OPERATOR_FUNCTOR(negate, -);
+        BINARY_OPERATOR_FUNCTOR(plus, +);
+        BINARY_OPERATOR_FUNCTOR(minus, -);
+        BINARY_OPERATOR_FUNCTOR(multiplies, *);
+        BINARY_OPERATOR_FUNCTOR(divides, /);
+
+#undef BINARY_OPERATOR_FUNCTOR
+#undef UNARY_OPERATOR_FUNCTOR
+
         template <class T>
         struct conditional_ternary
         {
@@ -110,9 +163,9 @@ namespace xt
     */
     template <class E>
     inline auto operator-(E&& e) noexcept
-        -> detail::xfunction_type_t<std::negate, E>
+        -> detail::xfunction_type_t<detail::negate, E>
     {
-        return detail::make_xfunction<std::negate>(std::forward<E>(e));
+        return detail::make_xfunction<detail::negate>(std::forward<E>(e));
     }
 
     /**
@@ -127,9 +180,9 @@ namespace xt
     */
     template <class E1, class E2>
     inline auto operator+(E1&& e1, E2&& e2) noexcept
-        -> detail::xfunction_type_t<std::plus, E1, E2>
+        -> detail::xfunction_type_t<detail::plus, E1, E2>
     {
-        return detail::make_xfunction<std::plus>(std::forward<E1>(e1), std::forward<E2>(e2));
+        return detail::make_xfunction<detail::plus>(std::forward<E1>(e1), std::forward<E2>(e2));
     }
 
     /**
@@ -144,9 +197,9 @@ namespace xt
     */
     template <class E1, class E2>
     inline auto operator-(E1&& e1, E2&& e2) noexcept
-        -> detail::xfunction_type_t<std::minus, E1, E2>
+        -> detail::xfunction_type_t<detail::minus, E1, E2>
     {
-        return detail::make_xfunction<std::minus>(std::forward<E1>(e1), std::forward<E2>(e2));
+        return detail::make_xfunction<detail::minus>(std::forward<E1>(e1), std::forward<E2>(e2));
     }
 
     /**
@@ -161,9 +214,9 @@ namespace xt
     */
     template <class E1, class E2>
     inline auto operator*(E1&& e1, E2&& e2) noexcept
-        -> detail::xfunction_type_t<std::multiplies, E1, E2>
+        -> detail::xfunction_type_t<detail::multiplies, E1, E2>
     {
-        return detail::make_xfunction<std::multiplies>(std::forward<E1>(e1), std::forward<E2>(e2));
+        return detail::make_xfunction<detail::multiplies>(std::forward<E1>(e1), std::forward<E2>(e2));
     }
 
     /**
@@ -178,9 +231,9 @@ namespace xt
     */
     template <class E1, class E2>
     inline auto operator/(E1&& e1, E2&& e2) noexcept
-        -> detail::xfunction_type_t<std::divides, E1, E2>
+        -> detail::xfunction_type_t<detail::divides, E1, E2>
     {
-        return detail::make_xfunction<std::divides>(std::forward<E1>(e1), std::forward<E2>(e2));
+        return detail::make_xfunction<detail::divides>(std::forward<E1>(e1), std::forward<E2>(e2));
     }
 
     /**
@@ -468,54 +521,219 @@ namespace xt
         return nonzero(condition);
     }
 
+    namespace detail
+    {
+        // Returns the position of the first of the n values value(i) whose
+        // truth value is target, or n if there is none. The values are tested
+        // by blocks with a branch-free loop, the block holding the value
+        // being searched for only when the test of the block succeeds.
+        template <class V>
+        inline std::size_t find_first_truth_value(const V& value, std::size_t n, bool target)
+        {
+            constexpr std::size_t block_size = 64;
+            for (std::size_t i = 0; i < n; i += block_size)
+            {
+                std::size_t last = std::min(i + block_size, n);
+                bool found = false;
+                for (std::size_t k = i; k < last; ++k)
+                {
+                    found |= static_cast<bool>(value(k)) == target;
+                }
+                if (found)
+                {
+                    for (std::size_t k = i; k < last; ++k)
+                    {
+                        if (static_cast<bool>(value(k)) == target)
+                        {
+                            return k;
+                        }
+                    }
+                }
+            }
+            return n;
+        }
+
+        template <class E>
+        inline std::size_t find_first_linear(const E& e, bool target)
+        {
+            return find_first_truth_value([&e](std::size_t i) { return e.data_element(i); }, e.size(), target);
+        }
+
+        template <class E>
+        inline std::size_t find_first_iterated(const E& e, bool target)
+        {
+            auto it = std::find_if(e.template cbegin<layout_type::row_major>(), e.template cend<layout_type::row_major>(),
+                                   [target](const typename E::value_type& el) { return static_cast<bool>(el) == target; });
+            return static_cast<std::size_t>(std::distance(e.template cbegin<layout_type::row_major>(), it));
+        }
+
+        // Returns the position of the first element of e whose truth value
+        // is target, or e.size() if there is none. The position is in
+        // row-major order, or in any order if any_order is true.
+        template <class E>
+        inline std::size_t find_first(const E& e, bool target, bool any_order = false)
+        {
+            auto linear = [target, any_order](const auto& d, layout_type l) {
+                if (l == layout_type::row_major || any_order || d.dimension() <= 1)
+                {
+                    return find_first_linear(d, target);
+                }
+                return find_first_iterated(d, target);
+            };
+            auto iterated = [target](const auto& d) {
+                return find_first_iterated(d, target);
+            };
+            return dispatch_linear(e, linear, iterated);
+        }
+
+        // Row-major container of values of type T with the dimension of E
+        // minus R: an xtensor if the shape of E is an array, an xarray
+        // otherwise. The containers are only complete once xtensor.hpp or
+        // xarray.hpp is included, hence the dependent types.
+        template <class E, class T, std::size_t R = 0, bool = is_array<typename E::shape_type>::value>
+        struct row_major_result
+        {
+            using type = xarray<T, layout_type::row_major>;
+        };
+
+        template <class E, class T, std::size_t R>
+        struct row_major_result<E, T, R, true>
+        {
+            using type = xtensor<T, std::tuple_size<typename E::shape_type>::value - R, layout_type::row_major>;
+        };
+
+        // Tells for each line of e along axis whether the truth value of one
+        // of its elements is target. The scan of a line stops at the first
+        // such element.
+        template <class E>
+        inline auto contains_truth_value(const E& e, std::size_t axis, bool target)
+        {
+            using result_container = typename row_major_result<E, bool, 1>::type;
+            result_container res = result_container::from_shape(shape_without_axis<result_container>(e, axis));
+            if (res.size() == 0)
+            {
+                return res;
+            }
+            auto scan = [&res, axis, target](const auto& d) {
+                line_geometry g = make_line_geometry(d.shape(), axis, layout_type::row_major);
+                bool* out = &res.data_element(0);
+                std::size_t grain = std::max(XTENSOR_PARALLEL_GRAIN_SIZE / std::max(g.n, std::size_t(1)), std::size_t(1));
+                parallel_for(g.size(), grain, [&d, &g, out, target](std::size_t first, std::size_t last) {
+                    for (std::size_t l = first; l < last; ++l)
+                    {
+                        std::size_t offset = g.line_offset(l);
+                        auto value = [&d, &g, offset](std::size_t k) { return d.data_element(offset + k * g.inner); };
+                        out[l] = find_first_truth_value(value, g.n, target) != g.n;
+                    }
+                });
+            };
+            auto evaluated = [&scan](const auto& d) {
+                typename row_major_result<E, typename E::value_type>::type values = d;
+                scan(values);
+            };
+            dispatch_linear(e, [&scan, &evaluated](const auto& d, layout_type l) {
+                if (l == layout_type::row_major)
+                {
+                    scan(d);
+                }
+                else
+                {
+                    evaluated(d);
+                }
+            }, evaluated);
+            return res;
+        }
+    }
+
     /**
     * @ingroup logical_operators
     * @brief Any
     *
     * Returns true if any of the values of \a e is truthy,
-    * false otherwise.
+    * false otherwise. The evaluation stops at the first truthy
+    * value.
     * @param e an \ref xexpression
     * @return a boolean
     */
     template <class E>
-    inline bool any(E&& e)
+    inline auto any(E&& e) -> std::enable_if_t<has_xexpression<std::decay_t<E>>::value, bool>
     {
-        using xtype = std::decay_t<E>;
-        if (xtype::static_layout == layout_type::row_major || xtype::static_layout == layout_type::column_major)
-        {
-            return std::any_of(e.cbegin(), e.cend(),
-                               [](const typename std::decay_t<E>::value_type& el) { return el; });
-        }
-        else
-        {
-            return std::any_of(e.begin(), e.end(),
-                               [](const typename std::decay_t<E>::value_type& el) { return el; });
-        }
+        return detail::find_first(e, true, true) != e.size();
     }
 
     /**
     * @ingroup logical_operators
-    * @brief Any
+    * @brief All
     *
     * Returns true if all of the values of \a e are truthy,
-    * false otherwise.
+    * false otherwise. The evaluation stops at the first falsy
+    * value.
     * @param e an \ref xexpression
     * @return a boolean
     */
     template <class E>
-    inline bool all(E&& e)
+    inline auto all(E&& e) -> std::enable_if_t<has_xexpression<std::decay_t<E>>::value, bool>
     {
-        using xtype = std::decay_t<E>;
-        if (xtype::static_layout == layout_type::row_major || xtype::static_layout == layout_type::column_major)
-        {
-            return std::all_of(e.cbegin(), e.cend(),
-                               [](const typename std::decay_t<E>::value_type& el) { return el; });
-        }
-        else
-        {
-            return std::all_of(e.begin(), e.end(),
-                               [](const typename std::decay_t<E>::value_type& el) { return el; });
-        }
+        return detail::find_first(e, false, true) == e.size();
+    }
+
+    /**
+    * @ingroup logical_operators
+    * @brief Tells for each line of \em e along the given axis whether
+    * one of its values is truthy.
+    *
+    * The scan of a line stops at its first truthy value. The lines are
+    * scanned in parallel.
+    * @param e an \ref xexpression
+    * @param axis the axis along which the values are tested
+    * @return a row-major container of booleans with the shape of \em e
+    * without \em axis: an xtensor if \em e has a fixed number of
+    * dimensions, an xarray otherwise
+    * @sa xt::any(E&&)
+    */
+    template <class E>
+    inline auto any(const xexpression<E>& e, std::size_t axis)
+    {
+        return detail::contains_truth_value(e.derived_cast(), axis, true);
+    }
+
+    /**
+    * @ingroup logical_operators
+    * @brief Tells for each line of \em e along the given axis whether
+    * all of its values are truthy.
+    *
+    * The scan of a line stops at its first falsy value. The lines are
+    * scanned in parallel.
+    * @param e an \ref xexpression
+    * @param axis the axis along which the values are tested
+    * @return a row-major container of booleans with the shape of \em e
+    * without \em axis: an xtensor if \em e has a fixed number of
+    * dimensions, an xarray otherwise
+    * @sa xt::all(E&&)
+    */
+    template <class E>
+    inline auto all(const xexpression<E>& e, std::size_t axis)
+    {
+        auto res = detail::contains_truth_value(e.derived_cast(), axis, false);
+        std::transform(res.data().cbegin(), res.data().cend(), res.data().begin(), [](bool b) { return !b; });
+        return res;
+    }
+
+    /**
+    * @ingroup logical_operators
+    * @brief First truthy value
+    *
+    * Returns the position, in row-major order, of the first
+    * truthy value of \a e. The evaluation stops at this value.
+    * @param e an \ref xexpression
+    * @return the position of the first truthy value, or the
+    * size of \a e if there is none
+    * @sa where
+    */
+    template <class E>
+    inline auto argwhere_first(E&& e) -> std::enable_if_t<has_xexpression<std::decay_t<E>>::value, std::size_t>
+    {
+        return detail::find_first(e, true);
     }
 }
 
@@ -0,0 +1,410 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XPARALLEL_HPP
+#define XPARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#ifdef XTENSOR_USE_THREADS
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#include "xtensor_config.hpp"
+
+namespace xt
+{
+
+    /*************************
+     * Thread count settings *
+     *************************/
+
+    std::size_t get_num_threads() noexcept;
+    void set_num_threads(std::size_t nb_threads);
+
+    bool deterministic_reductions() noexcept;
+    void set_deterministic_reductions(bool deterministic) noexcept;
+
+    /****************
+     * parallel_for *
+     ****************/
+
+    template <class F>
+    void parallel_for(std::size_t size, std::size_t grain, F&& f);
+
+    template <class F>
+    void parallel_for_each_chunk(std::size_t nb_chunks, F&& f);
+
+    std::size_t parallel_chunk_count(std::size_t size, std::size_t grain) noexcept;
+
+#ifdef XTENSOR_USE_THREADS
+
+    namespace detail
+    {
+        /****************
+         * xthread_pool *
+         ****************/
+
+        /**
+         * @class xthread_pool
+         * @brief Pool of worker threads used by the parallel kernels.
+         *
+         * The pool runs one parallel region at a time: the calling thread
+         * publishes a number of tasks, takes part to their execution and
+         * waits until all of them are done. A parallel region started from
+         * inside another one is run serially by the calling thread.
+         */
+        class xthread_pool
+        {
+        public:
+
+            using task_type = std::function<void(std::size_t)>;
+
+            static xthread_pool& instance();
+
+            ~xthread_pool();
+
+            xthread_pool(const xthread_pool&) = delete;
+            xthread_pool& operator=(const xthread_pool&) = delete;
+
+            std::size_t size() const noexcept;
+            void resize(std::size_t nb_threads);
+
+            void run(std::size_t nb_tasks, const task_type& task);
+
+            static bool& in_parallel_region() noexcept;
+
+        private:
+
+            xthread_pool();
+
+            void start_workers();
+            void stop_workers();
+            void worker_loop();
+            bool execute_next(std::unique_lock<std::mutex>& lock);
+
+            std::vector<std::thread> m_workers;
+            std::size_t m_nb_threads;
+
+            std::mutex m_region_mutex;
+            std::mutex m_mutex;
+            std::condition_variable m_task_cv;
+            std::condition_variable m_done_cv;
+
+            const task_type* p_task;
+            std::size_t m_nb_tasks;
+            std::size_t m_next_task;
+            std::size_t m_pending_tasks;
+            std::exception_ptr m_exception;
+            bool m_stop;
+        };
+    }
+
+#endif
+
+    /*****************************************
+     * Thread count settings implementation *
+     *****************************************/
+
+    /**
+     * Returns the number of threads used by the parallel kernels. This is
+     * always 1 when XTENSOR_USE_THREADS is not defined.
+     */
+    inline std::size_t get_num_threads() noexcept
+    {
+#ifdef XTENSOR_USE_THREADS
+        return detail::xthread_pool::instance().size();
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     * Sets the number of threads used by the parallel kernels, including
+     * the calling thread. A value of 0 restores the default, i.e. the number
+     * of hardware threads. This has no effect when XTENSOR_USE_THREADS is
+     * not defined.
+     * @param nb_threads the number of threads
+     */
+    inline void set_num_threads(std::size_t nb_threads)
+    {
+#ifdef XTENSOR_USE_THREADS
+        detail::xthread_pool::instance().resize(nb_threads);
+#else
+        (void)nb_threads;
+#endif
+    }
+
+    namespace detail
+    {
+        inline std::atomic<bool>& deterministic_reductions_flag() noexcept
+        {
+            static std::atomic<bool> flag(false);
+            return flag;
+        }
+    }
+
+    /**
+     * Returns true if the results of the parallel reductions do not depend
+     * on the number of threads.
+     * @sa set_deterministic_reductions
+     */
+    inline bool deterministic_reductions() noexcept
+    {
+        return detail::deterministic_reductions_flag().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets whether the results of the parallel reductions must be bitwise
+     * reproducible. When enabled, the reduced elements are split into chunks
+     * whose size does not depend on the number of threads, and the partial
+     * results are always combined in the same order. This is disabled by
+     * default: each thread then reduces a single chunk, and the results of
+     * floating point reductions may vary slightly with the number of threads.
+     * @param deterministic true to make the reductions reproducible
+     */
+    inline void set_deterministic_reductions(bool deterministic) noexcept
+    {
+        detail::deterministic_reductions_flag().store(deterministic, std::memory_order_relaxed);
+    }
+
+    /********************************
+     * parallel_for implementation *
+     ********************************/
+
+    /**
+     * Returns the number of chunks used by parallel_for to split a range
+     * of \c size elements, so that each chunk holds at least \c grain elements.
+     */
+    inline std::size_t parallel_chunk_count(std::size_t size, std::size_t grain) noexcept
+    {
+#ifdef XTENSOR_USE_THREADS
+        if (detail::xthread_pool::in_parallel_region())
+        {
+            return 1;
+        }
+        std::size_t max_chunks = size / std::max(grain, std::size_t(1));
+        return std::max(std::min(get_num_threads(), max_chunks), std::size_t(1));
+#else
+        (void)size;
+        (void)grain;
+        return 1;
+#endif
+    }
+
+    /**
+     * Calls \c f(i) for each \c i in [0, nb_chunks), possibly in parallel.
+     * The function returns when all the calls are done; the first exception
+     * thrown by \c f, if any, is rethrown in the calling thread.
+     * @param nb_chunks the number of chunks
+     * @param f the function to call
+     */
+    template <class F>
+    inline void parallel_for_each_chunk(std::size_t nb_chunks, F&& f)
+    {
+#ifdef XTENSOR_USE_THREADS
+        if (nb_chunks > 1 && !detail::xthread_pool::in_parallel_region())
+        {
+            detail::xthread_pool::task_type task = [&f](std::size_t i) { f(i); };
+            detail::xthread_pool::instance().run(nb_chunks, task);
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < nb_chunks; ++i)
+        {
+            f(i);
+        }
+    }
+
+    /**
+     * Splits the range [0, size) into contiguous chunks of at least \c grain
+     * elements and calls \c f(first, last) on each of them, possibly in parallel.
+     * @param size the size of the range
+     * @param grain the minimal number of elements processed by a thread
+     * @param f the function to call
+     */
+    template <class F>
+    inline void parallel_for(std::size_t size, std::size_t grain, F&& f)
+    {
+        std::size_t nb_chunks = parallel_chunk_count(size, grain);
+        if (nb_chunks == 1)
+        {
+            f(std::size_t(0), size);
+        }
+        else
+        {
+            parallel_for_each_chunk(nb_chunks, [&f, size, nb_chunks](std::size_t i) {
+                f(size * i / nb_chunks, size * (i + 1) / nb_chunks);
+            });
+        }
+    }
+
+#ifdef XTENSOR_USE_THREADS
+
+    namespace detail
+    {
+        /*******************************
+         * xthread_pool implementation *
+         *******************************/
+
+        inline xthread_pool& xthread_pool::instance()
+        {
+            static xthread_pool pool;
+            return pool;
+        }
+
+        inline xthread_pool::xthread_pool()
+            : m_nb_threads(std::max(std::size_t(std::thread::hardware_concurrency()), std::size_t(1))),
+              p_task(nullptr), m_nb_tasks(0), m_next_task(0), m_pending_tasks(0), m_stop(false)
+        {
+        }
+
+        inline xthread_pool::~xthread_pool()
+        {
+            stop_workers();
+        }
+
+        inline std::size_t xthread_pool::size() const noexcept
+        {
+            return m_nb_threads;
+        }
+
+        inline void xthread_pool::resize(std::size_t nb_threads)
+        {
+            std::lock_guard<std::mutex> region_lock(m_region_mutex);
+            stop_workers();
+            m_nb_threads = nb_threads != 0 ? nb_threads :
+                std::max(std::size_t(std::thread::hardware_concurrency()), std::size_t(1));
+        }
+
+        inline void xthread_pool::run(std::size_t nb_tasks, const task_type& task)
+        {
+            std::lock_guard<std::mutex> region_lock(m_region_mutex);
+            if (m_workers.size() + 1 < m_nb_threads)
+            {
+                start_workers();
+            }
+
+            bool& in_region = in_parallel_region();
+            in_region = true;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            p_task = &task;
+            m_nb_tasks = nb_tasks;
+            m_next_task = 0;
+            m_pending_tasks = nb_tasks;
+            m_exception = nullptr;
+            m_task_cv.notify_all();
+
+            while (execute_next(lock))
+            {
+            }
+            m_done_cv.wait(lock, [this]() { return m_pending_tasks == 0; });
+
+            p_task = nullptr;
+            std::exception_ptr exception = m_exception;
+            m_exception = nullptr;
+            lock.unlock();
+            in_region = false;
+
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        inline bool& xthread_pool::in_parallel_region() noexcept
+        {
+            static thread_local bool in_region = false;
+            return in_region;
+        }
+
+        inline void xthread_pool::start_workers()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = false;
+            while (m_workers.size() + 1 < m_nb_threads)
+            {
+                m_workers.emplace_back([this]() { worker_loop(); });
+            }
+        }
+
+        inline void xthread_pool::stop_workers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_task_cv.notify_all();
+            for (auto& worker : m_workers)
+            {
+                worker.join();
+            }
+            m_workers.clear();
+        }
+
+        inline void xthread_pool::worker_loop()
+        {
+            in_parallel_region() = true;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_task_cv.wait(lock, [this]() { return m_stop || m_next_task < m_nb_tasks; });
+                if (m_stop)
+                {
+                    return;
+                }
+                execute_next(lock);
+            }
+        }
+
+        // Must be called with m_mutex locked; executes one task with the
+        // mutex released. Returns false if there was no task left.
+        inline bool xthread_pool::execute_next(std::unique_lock<std::mutex>& lock)
+        {
+            if (m_next_task == m_nb_tasks)
+            {
+                return false;
+            }
+            std::size_t index = m_next_task++;
+            const task_type* task = p_task;
+            lock.unlock();
+            std::exception_ptr exception = nullptr;
+            try
+            {
+                (*task)(index);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            lock.lock();
+            if (exception && !m_exception)
+            {
+                m_exception = exception;
+            }
+            if (--m_pending_tasks == 0)
+            {
+                m_nb_tasks = 0;
+                m_next_task = 0;
+                m_done_cv.notify_all();
+            }
+            return true;
+        }
+    }
+
+#endif
+}
+
+#endif
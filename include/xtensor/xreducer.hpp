@@ -11,25 +11,323 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
-#ifdef X_OLD_CLANG
 #include <vector>
-#endif
 
+#include "xassign.hpp"
+#include "xbatch.hpp"
 #include "xbuilder.hpp"
 #include "xexpression.hpp"
 #include "xgenerator.hpp"
 #include "xiterable.hpp"
+#include "xoperation.hpp"
+#include "xparallel.hpp"
 #include "xreducer.hpp"
+#include "xstorage.hpp"
+#include "xstrides.hpp"
 #include "xutils.hpp"
 
 namespace xt
 {
 
+    /*************
+     * summation *
+     *************/
+
+    /**
+     * @brief Algorithms used to sum the elements of an expression.
+     *
+     * - naive: the elements are accumulated one after the other; the
+     *   rounding error may grow linearly with the number of elements.
+     * - pairwise: blocks of elements are accumulated and the results of
+     *   the blocks are summed two by two; the error grows logarithmically
+     *   for a cost close to the naive summation.
+     * - kahan: the rounding error of each addition is compensated; the
+     *   error does not depend on the number of elements, but each addition
+     *   costs four floating point operations. This must not be compiled
+     *   with options allowing to reassociate floating point operations,
+     *   such as -ffast-math.
+     *
+     * @sa sum, mean
+     */
+    enum class summation
+    {
+        naive,
+        pairwise,
+        kahan
+    };
+
+    namespace detail
+    {
+        // Sum using the given summation algorithm.
+        template <class T, summation S>
+        struct summation_plus : plus<T>
+        {
+        };
+
+        template <class F>
+        struct reducer_summation : std::integral_constant<summation, summation::naive>
+        {
+        };
+
+        template <class T, summation S>
+        struct reducer_summation<summation_plus<T, S>> : std::integral_constant<summation, S>
+        {
+        };
+    }
+
+    /*********************
+     * xreducer_functors *
+     *********************/
+
+    /**
+     * @class xreducer_functors
+     * @brief Specification of a reduction by an initial value, an
+     * accumulating function and a merging function.
+     *
+     * Each result of the reduction is computed by folding the reduced
+     * elements into the value returned by the init function, with
+     * \c reduce(acc, value), or \c reduce(acc, value, index) where
+     * \c index is the position of the element in the reduced axes
+     * flattened in row-major order. Accumulators computed separately, for
+     * instance by different threads, are combined with \c merge(acc1, acc2).
+     * The value type of the reducer is the type of the accumulator.
+     *
+     * The elements are not folded in a specified order: the reduction must
+     * not depend on it, up to rounding errors.
+     *
+     * @tparam REDUCE_FUNC the type of the accumulating function
+     * @tparam INIT_FUNC the type of the function returning the initial value
+     * @tparam MERGE_FUNC the type of the merging function
+     *
+     * @sa make_xreducer_functor, reduce
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    class xreducer_functors
+    {
+    public:
+
+        using reduce_functor_type = REDUCE_FUNC;
+        using init_functor_type = INIT_FUNC;
+        using merge_functor_type = MERGE_FUNC;
+        using accumulator_type = std::decay_t<decltype(std::declval<const INIT_FUNC&>()())>;
+
+        xreducer_functors(const reduce_functor_type& reduce, const init_functor_type& init,
+                          const merge_functor_type& merge);
+
+        accumulator_type init() const;
+
+        template <class T>
+        accumulator_type reduce(const accumulator_type& acc, const T& value, std::size_t index) const;
+
+        accumulator_type merge(const accumulator_type& lhs, const accumulator_type& rhs) const;
+
+        template <class B>
+        B simd_reduce(const B& acc, const B& values) const;
+        template <class B>
+        B simd_merge(const B& lhs, const B& rhs) const;
+
+    private:
+
+        template <class T>
+        accumulator_type reduce_impl(const accumulator_type& acc, const T& value, std::size_t index, std::true_type) const;
+        template <class T>
+        accumulator_type reduce_impl(const accumulator_type& acc, const T& value, std::size_t index, std::false_type) const;
+
+        reduce_functor_type m_reduce;
+        init_functor_type m_init;
+        merge_functor_type m_merge;
+    };
+
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    auto make_xreducer_functor(REDUCE_FUNC&& reduce, INIT_FUNC&& init, MERGE_FUNC&& merge);
+
+    template <class REDUCE_FUNC, class INIT_FUNC>
+    auto make_xreducer_functor(REDUCE_FUNC&& reduce, INIT_FUNC&& init);
+
+    /**
+     * @class const_value
+     * @brief Function returning a constant, used as initial value function
+     * of an \ref xreducer_functors.
+     */
+    template <class T>
+    struct const_value
+    {
+        using result_type = T;
+
+        constexpr explicit const_value(const T& value = T(0))
+            : m_value(value)
+        {
+        }
+
+        constexpr T operator()() const
+        {
+            return m_value;
+        }
+
+        T m_value;
+    };
+
+    namespace detail
+    {
+        template <class F, class A, class T, class = void>
+        struct has_indexed_reduce : std::false_type
+        {
+        };
+
+        template <class F, class A, class T>
+        struct has_indexed_reduce<F, A, T, typename enable_if_type<decltype(std::declval<const F&>()(std::declval<const A&>(), std::declval<const T&>(), std::size_t()))>::type>
+            : std::true_type
+        {
+        };
+
+        template <class F>
+        struct is_xreducer_functors : std::false_type
+        {
+        };
+
+        template <class R, class I, class M>
+        struct is_xreducer_functors<xreducer_functors<R, I, M>> : std::true_type
+        {
+        };
+
+        // Value type of a reducer whose functor is F and whose reduced
+        // expression has the value type T.
+        template <class F, class T>
+        struct reducer_value_type
+        {
+            using type = T;
+        };
+
+        template <class R, class I, class M, class T>
+        struct reducer_value_type<xreducer_functors<R, I, M>, T>
+        {
+            using type = typename xreducer_functors<R, I, M>::accumulator_type;
+        };
+
+        // Whether the reducer needs the positions of the reduced elements.
+        template <class F, class T>
+        struct reducer_uses_index : std::false_type
+        {
+        };
+
+        template <class R, class I, class M, class T>
+        struct reducer_uses_index<xreducer_functors<R, I, M>, T>
+            : has_indexed_reduce<R, typename xreducer_functors<R, I, M>::accumulator_type, T>
+        {
+        };
+
+        template <class F, class T>
+        inline T reducer_merge(const F& f, const T& lhs, const T& rhs)
+        {
+            return f(lhs, rhs);
+        }
+
+        template <class R, class I, class M, class T>
+        inline T reducer_merge(const xreducer_functors<R, I, M>& f, const T& lhs, const T& rhs)
+        {
+            return f.merge(lhs, rhs);
+        }
+
+        // Reduction of the data element i of e alone.
+        template <class F, class E>
+        inline auto reduce_element(const F&, const E& e, std::size_t i)
+        {
+            return e.data_element(i);
+        }
+
+        template <class R, class I, class M, class E>
+        inline auto reduce_element(const xreducer_functors<R, I, M>& f, const E& e, std::size_t i)
+        {
+            return f.reduce(f.init(), e.data_element(i), 0);
+        }
+    }
+
+    /*********
+     * xaxes *
+     *********/
+
+    namespace detail
+    {
+        template <std::size_t... I>
+        struct strictly_increasing : std::true_type
+        {
+        };
+
+        template <std::size_t I0, std::size_t I1, std::size_t... I>
+        struct strictly_increasing<I0, I1, I...>
+            : std::integral_constant<bool, (I0 < I1) && strictly_increasing<I1, I...>::value>
+        {
+        };
+    }
+
+    /**
+     * @class xaxes
+     * @brief Reducing axes known at compile time.
+     *
+     * The xaxes class can be passed to the reducing functions in place of
+     * a runtime list of axes. Reducing an expression with a fixed shape
+     * then gives a fixed shape, and the reducer resolves the nesting of
+     * its loops at compile time.
+     *
+     * @tparam I the reducing axes, in increasing order
+     */
+    template <std::size_t... I>
+    class xaxes
+    {
+    public:
+
+        static_assert(sizeof...(I) != 0, "xaxes requires at least one axis");
+        static_assert(detail::strictly_increasing<I...>::value, "Reducing axes should be sorted");
+
+        using value_type = std::size_t;
+        using size_type = std::size_t;
+        using const_iterator = const value_type*;
+
+        static constexpr value_type values[sizeof...(I)] = {I...};
+
+        static constexpr size_type size() noexcept;
+        constexpr value_type operator[](size_type i) const noexcept;
+
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+    };
+
+    template <std::size_t... I>
+    constexpr typename xaxes<I...>::value_type xaxes<I...>::values[sizeof...(I)];
+
+    namespace detail
+    {
+        template <class X>
+        struct is_xaxes : std::false_type
+        {
+        };
+
+        template <std::size_t... I>
+        struct is_xaxes<xaxes<I...>> : std::true_type
+        {
+        };
+
+        template <class X>
+        struct is_xaxes<const X> : is_xaxes<X>
+        {
+        };
+
+        template <class X>
+        struct is_xaxes<X&> : is_xaxes<X>
+        {
+        };
+    }
+
     /**********
      * reduce *
      **********/
@@ -37,6 +335,9 @@ namespace xt
     template <class F, class E, class X>
     auto reduce(F&& f, E&& e, X&& axes) noexcept;
 
+    template <std::size_t I, std::size_t... J, class F, class E>
+    auto reduce(F&& f, E&& e) noexcept;
+
     template <class F, class E>
     auto reduce(F&& f, E&& e) noexcept;
 
@@ -61,11 +362,17 @@ namespace xt
     template <class F, class CT, class X>
     class xreducer_stepper;
 
+    namespace detail
+    {
+        template <class T, class S>
+        class xreducer_cache;
+    }
+
     template <class F, class CT, class X>
     struct xiterable_inner_types<xreducer<F, CT, X>>
     {
         using xexpression_type = std::decay_t<CT>;
-        using inner_shape_type = typename xreducer_shape_type<typename xexpression_type::shape_type, X>::type;
+        using inner_shape_type = typename xreducer_shape_type<typename xexpression_type::shape_type, std::decay_t<X>>::type;
         using const_stepper = xreducer_stepper<F, CT, X>;
         using stepper = const_stepper;
     };
@@ -91,11 +398,11 @@ namespace xt
     public:
 
         using self_type = xreducer<F, CT, X>;
-        using functor_type = typename std::remove_reference<F>::type;
+        using functor_type = std::decay_t<F>;
         using xexpression_type = std::decay_t<CT>;
         using axes_type = X;
 
-        using value_type = typename xexpression_type::value_type;
+        using value_type = typename detail::reducer_value_type<functor_type, typename xexpression_type::value_type>::type;
         using reference = value_type;
         using const_reference = value_type;
         using pointer = value_type*;
@@ -136,18 +443,49 @@ namespace xt
         template <class S>
         bool is_trivial_broadcast(const S& strides) const noexcept;
 
+        template <class Func>
+        bool visit_memory(Func&& f) const;
+
         template <class S>
-        const_stepper stepper_begin(const S& shape) const noexcept;
+        const_stepper stepper_begin(const S& shape) const;
         template <class S>
-        const_stepper stepper_end(const S& shape, layout_type) const noexcept;
+        const_stepper stepper_end(const S& shape, layout_type) const;
+
+        template <class E>
+        void assign_to(xexpression<E>& e) const;
 
     private:
 
+        using cache_type = detail::xreducer_cache<value_type, inner_shape_type>;
+        using strides_type = typename xexpression_type::shape_type;
+        using uses_index = detail::reducer_uses_index<functor_type, typename xexpression_type::value_type>;
+
+        template <class It>
+        const_reference element_impl(It first, It last, std::true_type) const;
+        template <class It>
+        const_reference element_impl(It first, It last, std::false_type) const;
+
+        template <class E>
+        bool assign_contiguous(E& e, std::true_type) const;
+        template <class E>
+        bool assign_contiguous(E& e, std::false_type) const;
+
+        template <class S>
+        std::shared_ptr<const cache_type> broadcast_cache(const S& shape) const;
+
+        layout_type storage_layout(strides_type& strides) const;
+        layout_type contiguous_reduction_layout(strides_type& strides) const;
+        size_type reduced_size() const noexcept;
+        bool is_reduced_axis(size_type d) const noexcept;
+
         CT m_e;
         functor_type m_f;
         axes_type m_axes;
         inner_shape_type m_shape;
         shape_type m_dim_mapping;
+        // Values of the reducer shared by the steppers of a broadcasting
+        // traversal, freed when the last of them is destroyed.
+        mutable std::weak_ptr<const cache_type> m_cache;
 
         friend class xreducer_stepper<F, CT, X>;
     };
@@ -160,7 +498,8 @@ namespace xt
      * @brief Returns an \ref xexpression applying the speficied reducing
      * function to an expresssion over the given axes.
      *
-     * @param f the reducing function to apply.
+     * @param f the reducing function to apply, or an \ref xreducer_functors
+     * specifying the reduction.
      * @param e the \ref xexpression to reduce.
      * @param axes the list of axes.
      *
@@ -175,6 +514,24 @@ namespace xt
         return reducer_type(std::forward<F>(f), std::forward<E>(e), std::forward<X>(axes));
     }
 
+    /**
+     * @brief Returns an \ref xexpression applying the specified reducing
+     * function to an expression over the axes given as template arguments.
+     *
+     * @tparam I the first axis
+     * @tparam J the following axes
+     * @param f the reducing function to apply, or an \ref xreducer_functors
+     * specifying the reduction.
+     * @param e the \ref xexpression to reduce.
+     *
+     * @sa xaxes
+     */
+    template <std::size_t I, std::size_t... J, class F, class E>
+    inline auto reduce(F&& f, E&& e) noexcept
+    {
+        return reduce(std::forward<F>(f), std::forward<E>(e), xaxes<I, J...>());
+    }
+
     template <class F, class E>
     inline auto reduce(F&& f, E&& e) noexcept
     {
@@ -202,6 +559,167 @@ namespace xt
     }
 #endif
 
+    /************************
+     * xaxes implementation *
+     ************************/
+
+    /**
+     * Returns the number of axes.
+     */
+    template <std::size_t... I>
+    constexpr auto xaxes<I...>::size() noexcept -> size_type
+    {
+        return sizeof...(I);
+    }
+
+    /**
+     * Returns the i-th axis.
+     */
+    template <std::size_t... I>
+    constexpr auto xaxes<I...>::operator[](size_type i) const noexcept -> value_type
+    {
+        return values[i];
+    }
+
+    template <std::size_t... I>
+    inline auto xaxes<I...>::begin() const noexcept -> const_iterator
+    {
+        return values;
+    }
+
+    template <std::size_t... I>
+    inline auto xaxes<I...>::end() const noexcept -> const_iterator
+    {
+        return values + sizeof...(I);
+    }
+
+    template <std::size_t... I>
+    inline auto xaxes<I...>::cbegin() const noexcept -> const_iterator
+    {
+        return begin();
+    }
+
+    template <std::size_t... I>
+    inline auto xaxes<I...>::cend() const noexcept -> const_iterator
+    {
+        return end();
+    }
+
+    /************************************
+     * xreducer_functors implementation *
+     ************************************/
+
+    /**
+     * Constructs the specification of a reduction.
+     * @param reduce the function folding an element into an accumulator
+     * @param init the function returning the initial accumulator
+     * @param merge the function combining two accumulators
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    inline xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::xreducer_functors(const reduce_functor_type& reduce,
+                                                                                   const init_functor_type& init,
+                                                                                   const merge_functor_type& merge)
+        : m_reduce(reduce), m_init(init), m_merge(merge)
+    {
+    }
+
+    /**
+     * Returns the initial value of an accumulator.
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    inline auto xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::init() const -> accumulator_type
+    {
+        return m_init();
+    }
+
+    /**
+     * Folds an element into an accumulator.
+     * @param acc the accumulator
+     * @param value the element
+     * @param index the position of the element in the reduced axes, flattened
+     * in row-major order; it is passed to the reduce function only if it
+     * accepts a third argument.
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    template <class T>
+    inline auto xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::reduce(const accumulator_type& acc, const T& value,
+                                                                             std::size_t index) const -> accumulator_type
+    {
+        return reduce_impl(acc, value, index, detail::has_indexed_reduce<REDUCE_FUNC, accumulator_type, T>());
+    }
+
+    /**
+     * Combines two accumulators.
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    inline auto xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::merge(const accumulator_type& lhs,
+                                                                            const accumulator_type& rhs) const -> accumulator_type
+    {
+        return m_merge(lhs, rhs);
+    }
+
+    /**
+     * Folds a batch of elements into a batch of accumulators, with the
+     * \c simd_apply method of the reduce function.
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    template <class B>
+    inline B xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::simd_reduce(const B& acc, const B& values) const
+    {
+        return m_reduce.simd_apply(acc, values);
+    }
+
+    /**
+     * Combines two batches of accumulators, with the \c simd_apply method
+     * of the merge function.
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    template <class B>
+    inline B xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::simd_merge(const B& lhs, const B& rhs) const
+    {
+        return m_merge.simd_apply(lhs, rhs);
+    }
+
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    template <class T>
+    inline auto xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::reduce_impl(const accumulator_type& acc, const T& value,
+                                                                                  std::size_t index, std::true_type) const -> accumulator_type
+    {
+        return m_reduce(acc, value, index);
+    }
+
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    template <class T>
+    inline auto xreducer_functors<REDUCE_FUNC, INIT_FUNC, MERGE_FUNC>::reduce_impl(const accumulator_type& acc, const T& value,
+                                                                                  std::size_t, std::false_type) const -> accumulator_type
+    {
+        return m_reduce(acc, value);
+    }
+
+    /**
+     * @brief Returns the specification of a reduction, to be passed to \ref reduce.
+     *
+     * @param reduce the function folding an element into an accumulator, called
+     * with the accumulator, the element and optionally its position in the
+     * reduced axes
+     * @param init the function returning the initial accumulator
+     * @param merge the function combining two accumulators, \c reduce if omitted
+     * @sa xreducer_functors
+     */
+    template <class REDUCE_FUNC, class INIT_FUNC, class MERGE_FUNC>
+    inline auto make_xreducer_functor(REDUCE_FUNC&& reduce, INIT_FUNC&& init, MERGE_FUNC&& merge)
+    {
+        using functors_type = xreducer_functors<std::decay_t<REDUCE_FUNC>, std::decay_t<INIT_FUNC>, std::decay_t<MERGE_FUNC>>;
+        return functors_type(std::forward<REDUCE_FUNC>(reduce), std::forward<INIT_FUNC>(init), std::forward<MERGE_FUNC>(merge));
+    }
+
+    template <class REDUCE_FUNC, class INIT_FUNC>
+    inline auto make_xreducer_functor(REDUCE_FUNC&& reduce, INIT_FUNC&& init)
+    {
+        using functors_type = xreducer_functors<std::decay_t<REDUCE_FUNC>, std::decay_t<INIT_FUNC>, std::decay_t<REDUCE_FUNC>>;
+        return functors_type(reduce, std::forward<INIT_FUNC>(init), reduce);
+    }
+
     /********************
      * xreducer_stepper *
      ********************/
@@ -223,8 +741,11 @@ namespace xt
         using xexpression_type = typename xreducer_type::xexpression_type;
         using substepper_type = typename xexpression_type::const_stepper;
         using shape_type = typename xreducer_type::shape_type;
+        using cache_type = typename xreducer_type::cache_type;
+        using cache_stepper = xstepper<const cache_type>;
 
         xreducer_stepper(const xreducer_type& red, size_type offset, bool end = false, layout_type l = layout_type::row_major);
+        xreducer_stepper(const xreducer_type& red, std::shared_ptr<const cache_type> cache, cache_stepper st);
 
         reference operator*() const;
 
@@ -240,7 +761,32 @@ namespace xt
 
     private:
 
+        using summation_type = detail::reducer_summation<typename xreducer_type::functor_type>;
+
+        using functors_type = detail::is_xreducer_functors<typename xreducer_type::functor_type>;
+        using axes_type = std::decay_t<X>;
+        using fixed_axes = std::integral_constant<bool, detail::is_xaxes<X>::value &&
+                                                        summation_type::value == summation::naive>;
+
+        reference dereference(std::false_type) const;
+        reference dereference(std::true_type) const;
+        void fold(size_type dim, reference& acc, size_type index) const;
+
+        reference aggregate_root(std::false_type) const;
+        reference aggregate_root(std::true_type) const;
+        template <std::size_t D>
+        reference aggregate_fixed(std::integral_constant<std::size_t, D>) const;
+        template <std::size_t D>
+        reference aggregate_fixed_inner(std::integral_constant<std::size_t, D>, std::false_type) const;
+        template <std::size_t D>
+        reference aggregate_fixed_inner(std::integral_constant<std::size_t, D>, std::true_type) const;
+
         reference aggregate(size_type dim) const;
+        reference aggregate(size_type dim, std::integral_constant<summation, summation::naive>) const;
+        reference aggregate(size_type dim, std::integral_constant<summation, summation::pairwise>) const;
+        reference aggregate(size_type dim, std::integral_constant<summation, summation::kahan>) const;
+        reference aggregate_range(size_type dim, size_type size) const;
+        reference aggregate_inner(size_type dim) const;
 
         substepper_type get_substepper_begin() const;
         size_type get_dim(size_type dim) const noexcept;
@@ -250,6 +796,8 @@ namespace xt
         const xreducer_type& m_reducer;
         size_type m_offset;
         mutable substepper_type m_stepper;
+        std::shared_ptr<const cache_type> m_cache;
+        cache_stepper m_cache_stepper;
     };
 
     template <class F, class CT, class X>
@@ -277,8 +825,89 @@ namespace xt
         using type = std::array<I2, N1 - N2>;
     };
 
+    template <class I1, std::size_t N1, std::size_t... I>
+    struct xreducer_shape_type<std::array<I1, N1>, xaxes<I...>>
+    {
+        static_assert(N1 >= sizeof...(I), "Too many reducing axes");
+        using type = std::array<I1, N1 - sizeof...(I)>;
+    };
+
     namespace detail
     {
+        /**
+         * Row-major buffer holding the evaluated values of a reducer,
+         * traversed with an xstepper when the reducer is broadcast.
+         */
+        template <class T, class S>
+        class xreducer_cache
+        {
+        public:
+
+            using value_type = T;
+            using storage_type = uvector<T>;
+            using const_container_iterator = typename storage_type::const_iterator;
+            using size_type = typename storage_type::size_type;
+            using shape_type = S;
+            using strides_type = S;
+
+            template <class E>
+            explicit xreducer_cache(const E& e);
+
+            size_type dimension() const noexcept;
+            const strides_type& strides() const noexcept;
+            const strides_type& backstrides() const noexcept;
+
+            const_container_iterator data_xbegin() const noexcept;
+            const_container_iterator data_xend(layout_type l) const noexcept;
+
+        private:
+
+            strides_type m_strides;
+            strides_type m_backstrides;
+            storage_type m_data;
+        };
+
+        template <class T, class S>
+        template <class E>
+        inline xreducer_cache<T, S>::xreducer_cache(const E& e)
+            : m_strides(make_sequence<strides_type>(e.dimension(), 0)),
+              m_backstrides(make_sequence<strides_type>(e.dimension(), 0)),
+              m_data(e.size())
+        {
+            xt::compute_strides(e.shape(), layout_type::row_major, m_strides, m_backstrides);
+            std::copy(e.template cbegin<layout_type::row_major>(), e.template cend<layout_type::row_major>(), m_data.begin());
+        }
+
+        template <class T, class S>
+        inline auto xreducer_cache<T, S>::dimension() const noexcept -> size_type
+        {
+            return m_strides.size();
+        }
+
+        template <class T, class S>
+        inline auto xreducer_cache<T, S>::strides() const noexcept -> const strides_type&
+        {
+            return m_strides;
+        }
+
+        template <class T, class S>
+        inline auto xreducer_cache<T, S>::backstrides() const noexcept -> const strides_type&
+        {
+            return m_backstrides;
+        }
+
+        template <class T, class S>
+        inline auto xreducer_cache<T, S>::data_xbegin() const noexcept -> const_container_iterator
+        {
+            return m_data.cbegin();
+        }
+
+        template <class T, class S>
+        inline auto xreducer_cache<T, S>::data_xend(layout_type l) const noexcept -> const_container_iterator
+        {
+            return strided_data_end(*this, m_data.cend(), l);
+        }
+
         template <class InputIt, class ExcludeIt, class OutputIt>
         inline void excluding_copy(InputIt first, InputIt last,
                                    ExcludeIt e_first, ExcludeIt e_last,
@@ -305,21 +934,1011 @@ namespace xt
             std::iota(map_first, map_first + end, diff);
             std::copy(iter, last, d_first);
         }
-    }
 
-    /***************************
-     * xreducer implementation *
-     ***************************/
+        template <class F, class E>
+        struct use_simd_reduce
+        {
+            using value_type = typename E::value_type;
+            using batch_type = xsimd_batch_t<value_type>;
+            static constexpr bool value = has_simd_interface<E>::value && has_simd<value_type>::value &&
+                has_simd_apply<F, batch_type, batch_type>::value;
+        };
+
+        // Adds v to sum, keeping track of the rounding error in comp.
+        template <class T>
+        inline void kahan_add(T& sum, T& comp, const T& v)
+        {
+            T y = v - comp;
+            T t = sum + y;
+            comp = (t - sum) - y;
+            sum = t;
+        }
 
-    /**
-     * @name Constructor
-     */
-    //@{
-    /**
-     * Constructs an xreducer expression applying the specified
-     * function to the given expression over the given axes.
-     *
-     * @param func the function to apply
+        // Reduces the data elements [first, last) of e, last must be
+        // greater than first.
+        template <bool simd>
+        struct reducer_loop
+        {
+            template <class F, class E, class S>
+            static typename E::value_type run(const F& f, const E& e, S first, S last)
+            {
+                return run(f, e.data_element(first), e, first + 1, last);
+            }
+
+            template <class F, class T, class E, class S>
+            static T run(const F& f, T init, const E& e, S first, S last)
+            {
+                for (S i = first; i < last; ++i)
+                {
+                    init = f(init, e.data_element(i));
+                }
+                return init;
+            }
+
+            template <class E, class S, class T>
+            static void assign(const E& e, S first, S last, T* out)
+            {
+                for (S i = first; i < last; ++i, ++out)
+                {
+                    *out = e.data_element(i);
+                }
+            }
+
+            template <class F, class E, class S, class T>
+            static void accumulate(const F& f, const E& e, S first, S last, T* out)
+            {
+                for (S i = first; i < last; ++i, ++out)
+                {
+                    *out = f(*out, e.data_element(i));
+                }
+            }
+        };
+
+        // Functors providing simd_apply are associative: long ranges are
+        // accumulated in four independent batches to hide the latency of
+        // the functor, and the batches are reduced at the end.
+        template <>
+        struct reducer_loop<true>
+        {
+            template <class F, class E, class S>
+            static typename E::value_type run(const F& f, const E& e, S first, S last)
+            {
+                using value_type = typename E::value_type;
+                constexpr S batch_size = xsimd_traits<value_type>::size;
+                if (last - first < batch_size)
+                {
+                    return reducer_loop<false>::run(f, e, first, last);
+                }
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                return reduce_batch(f, run_batches(f, e, first, simd_last), e, simd_last, last);
+            }
+
+            // Reduces the data elements [first, last) of e into a batch,
+            // last - first must be a non null multiple of the batch size.
+            template <class F, class E, class S>
+            static xsimd_batch_t<typename E::value_type> run_batches(const F& f, const E& e, S first, S last)
+            {
+                using value_type = typename E::value_type;
+                using batch_type = xsimd_batch_t<value_type>;
+                constexpr S batch_size = xsimd_traits<value_type>::size;
+                constexpr S block_size = 4 * batch_size;
+
+                batch_type acc0 = e.template load_batch<batch_type>(first);
+                S i = first + batch_size;
+                if (last - first >= block_size)
+                {
+                    batch_type acc1 = e.template load_batch<batch_type>(first + batch_size);
+                    batch_type acc2 = e.template load_batch<batch_type>(first + 2 * batch_size);
+                    batch_type acc3 = e.template load_batch<batch_type>(first + 3 * batch_size);
+                    S block_last = first + (last - first) / block_size * block_size;
+                    for (i = first + block_size; i < block_last; i += block_size)
+                    {
+                        acc0 = f.simd_apply(acc0, e.template load_batch<batch_type>(i));
+                        acc1 = f.simd_apply(acc1, e.template load_batch<batch_type>(i + batch_size));
+                        acc2 = f.simd_apply(acc2, e.template load_batch<batch_type>(i + 2 * batch_size));
+                        acc3 = f.simd_apply(acc3, e.template load_batch<batch_type>(i + 3 * batch_size));
+                    }
+                    acc0 = f.simd_apply(f.simd_apply(acc0, acc1), f.simd_apply(acc2, acc3));
+                }
+                for (; i < last; i += batch_size)
+                {
+                    acc0 = f.simd_apply(acc0, e.template load_batch<batch_type>(i));
+                }
+                return acc0;
+            }
+
+            // Reduces the lanes of acc and the data elements [first, last) of e.
+            template <class F, class B, class E, class S>
+            static typename E::value_type reduce_batch(const F& f, const B& acc, const E& e, S first, S last)
+            {
+                using value_type = typename E::value_type;
+                constexpr S batch_size = xsimd_traits<value_type>::size;
+                value_type buffer[batch_size];
+                acc.store_unaligned(buffer);
+                value_type res = buffer[0];
+                for (S j = 1; j < batch_size; ++j)
+                {
+                    res = f(res, buffer[j]);
+                }
+                for (S i = first; i < last; ++i)
+                {
+                    res = f(res, e.data_element(i));
+                }
+                return res;
+            }
+
+            template <class F, class T, class E, class S>
+            static T run(const F& f, T init, const E& e, S first, S last)
+            {
+                return first < last ? f(init, run(f, e, first, last)) : init;
+            }
+
+            template <class E, class S, class T>
+            static void assign(const E& e, S first, S last, T* out)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                S i = first;
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                for (; i < simd_last; i += batch_size, out += batch_size)
+                {
+                    e.template load_batch<batch_type>(i).store_unaligned(out);
+                }
+                reducer_loop<false>::assign(e, i, last, out);
+            }
+
+            template <class F, class E, class S, class T>
+            static void accumulate(const F& f, const E& e, S first, S last, T* out)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                S i = first;
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                for (; i < simd_last; i += batch_size, out += batch_size)
+                {
+                    f.simd_apply(batch_type::load_unaligned(out), e.template load_batch<batch_type>(i)).store_unaligned(out);
+                }
+                reducer_loop<false>::accumulate(f, e, i, last, out);
+            }
+        };
+
+        /**
+         * Kernels of the reductions of contiguous data elements for a given
+         * summation algorithm. run folds a range of data elements into a
+         * result, add_run folds it into an existing result, assign copies a
+         * range into a range of results and accumulate folds it element-wise
+         * into a range of results. The compensations of the kahan summation
+         * are held in a buffer indexed like the results, unused otherwise.
+         */
+        template <summation SA, bool simd>
+        struct reducer_kernel
+        {
+            using loop_type = reducer_loop<simd>;
+
+            template <class F, class E, class S>
+            static typename E::value_type run(const F& f, const E& e, S first, S last, S)
+            {
+                return loop_type::run(f, e, first, last);
+            }
+
+            template <class F, class E, class S, class T>
+            static void add_run(const F& f, const E& e, S first, S last, T* res, T*, S)
+            {
+                *res = loop_type::run(f, *res, e, first, last);
+            }
+
+            template <class F, class E, class S, class T>
+            static void assign(const F&, const E& e, S first, S last, T* out, T*, S)
+            {
+                loop_type::assign(e, first, last, out);
+            }
+
+            template <class F, class E, class S, class T>
+            static void accumulate(const F& f, const E& e, S first, S last, T* out, T*, S)
+            {
+                loop_type::accumulate(f, e, first, last, out);
+            }
+        };
+
+        // Ranges are split in halves until they hold at most 64 values,
+        // or 64 batches when the functor provides simd_apply, which are
+        // accumulated by the naive kernel.
+        template <bool simd>
+        struct reducer_kernel<summation::pairwise, simd> : reducer_kernel<summation::naive, simd>
+        {
+            template <class F, class E, class S>
+            static typename E::value_type run(const F& f, const E& e, S first, S last, S)
+            {
+                return run_impl(f, e, first, last, std::integral_constant<bool, simd>());
+            }
+
+            template <class F, class E, class S, class T>
+            static void add_run(const F& f, const E& e, S first, S last, T* res, T*, S)
+            {
+                *res = f(*res, run_impl(f, e, first, last, std::integral_constant<bool, simd>()));
+            }
+
+        private:
+
+            template <class F, class E, class S>
+            static typename E::value_type run_impl(const F& f, const E& e, S first, S last, std::false_type)
+            {
+                if (last - first <= 64)
+                {
+                    return reducer_loop<false>::run(f, e, first, last);
+                }
+                S middle = first + (last - first) / 2;
+                return f(run_impl(f, e, first, middle, std::false_type()), run_impl(f, e, middle, last, std::false_type()));
+            }
+
+            template <class F, class E, class S>
+            static typename E::value_type run_impl(const F& f, const E& e, S first, S last, std::true_type)
+            {
+                constexpr S batch_size = xsimd_traits<typename E::value_type>::size;
+                if (last - first < batch_size)
+                {
+                    return reducer_loop<false>::run(f, e, first, last);
+                }
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                return reducer_loop<true>::reduce_batch(f, run_batches(f, e, first, simd_last), e, simd_last, last);
+            }
+
+            template <class F, class E, class S>
+            static xsimd_batch_t<typename E::value_type> run_batches(const F& f, const E& e, S first, S last)
+            {
+                constexpr S batch_size = xsimd_traits<typename E::value_type>::size;
+                if (last - first <= 64 * batch_size)
+                {
+                    return reducer_loop<true>::run_batches(f, e, first, last);
+                }
+                S middle = first + (last - first) / (2 * batch_size) * batch_size;
+                return f.simd_apply(run_batches(f, e, first, middle), run_batches(f, e, middle, last));
+            }
+        };
+
+        template <bool simd>
+        struct reducer_kernel<summation::kahan, simd>
+        {
+            template <class F, class E, class S>
+            static typename E::value_type run(const F&, const E& e, S first, S last, S)
+            {
+                using value_type = typename E::value_type;
+                value_type sum = e.data_element(first);
+                value_type comp = value_type(0);
+                run_impl(e, first + 1, last, sum, comp, std::integral_constant<bool, simd>());
+                return sum;
+            }
+
+            template <class F, class E, class S, class T>
+            static void add_run(const F& f, const E& e, S first, S last, T* res, T* comp, S index)
+            {
+                kahan_add(*res, *comp, T(run(f, e, first, last, index)));
+            }
+
+            template <class F, class E, class S, class T>
+            static void assign(const F&, const E& e, S first, S last, T* out, T* comp, S)
+            {
+                reducer_loop<simd>::assign(e, first, last, out);
+                std::fill(comp, comp + (last - first), T(0));
+            }
+
+            template <class F, class E, class S, class T>
+            static void accumulate(const F&, const E& e, S first, S last, T* out, T* comp, S)
+            {
+                accumulate_impl(e, first, last, out, comp, std::integral_constant<bool, simd>());
+            }
+
+        private:
+
+            template <class E, class S, class T>
+            static void run_impl(const E& e, S first, S last, T& sum, T& comp, std::false_type)
+            {
+                for (S i = first; i < last; ++i)
+                {
+                    kahan_add(sum, comp, T(e.data_element(i)));
+                }
+            }
+
+            // The batches are compensated separately, their lanes are then
+            // added with their compensations.
+            template <class E, class S, class T>
+            static void run_impl(const E& e, S first, S last, T& sum, T& comp, std::true_type)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                S i = first;
+                if (last - first >= 2 * batch_size)
+                {
+                    batch_type bsum0 = e.template load_batch<batch_type>(i);
+                    batch_type bsum1 = e.template load_batch<batch_type>(i + batch_size);
+                    batch_type bcomp0(T(0));
+                    batch_type bcomp1(T(0));
+                    S simd_last = first + (last - first) / (2 * batch_size) * (2 * batch_size);
+                    for (i += 2 * batch_size; i < simd_last; i += 2 * batch_size)
+                    {
+                        kahan_add(bsum0, bcomp0, e.template load_batch<batch_type>(i));
+                        kahan_add(bsum1, bcomp1, e.template load_batch<batch_type>(i + batch_size));
+                    }
+                    kahan_add(bsum0, bcomp0, bsum1);
+                    kahan_add(bsum0, bcomp0, batch_type(T(0)) - bcomp1);
+                    T sums[batch_size];
+                    T comps[batch_size];
+                    bsum0.store_unaligned(sums);
+                    bcomp0.store_unaligned(comps);
+                    for (S j = 0; j < batch_size; ++j)
+                    {
+                        kahan_add(sum, comp, sums[j]);
+                        kahan_add(sum, comp, -comps[j]);
+                    }
+                }
+                run_impl(e, i, last, sum, comp, std::false_type());
+            }
+
+            template <class E, class S, class T>
+            static void accumulate_impl(const E& e, S first, S last, T* out, T* comp, std::false_type)
+            {
+                for (S i = first; i < last; ++i, ++out, ++comp)
+                {
+                    kahan_add(*out, *comp, T(e.data_element(i)));
+                }
+            }
+
+            template <class E, class S, class T>
+            static void accumulate_impl(const E& e, S first, S last, T* out, T* comp, std::true_type)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                S i = first;
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                for (; i < simd_last; i += batch_size, out += batch_size, comp += batch_size)
+                {
+                    batch_type bsum = batch_type::load_unaligned(out);
+                    batch_type bcomp = batch_type::load_unaligned(comp);
+                    kahan_add(bsum, bcomp, e.template load_batch<batch_type>(i));
+                    bsum.store_unaligned(out);
+                    bcomp.store_unaligned(comp);
+                }
+                accumulate_impl(e, i, last, out, comp, std::false_type());
+            }
+        };
+
+        // Kernel of the reductions specified by an xreducer_functors: the
+        // data elements are folded one by one, with their position in the
+        // reduced axes. Each data element of a reduced run is one position
+        // further than the previous one.
+        struct functors_kernel
+        {
+            template <class F, class E, class S>
+            static typename F::accumulator_type run(const F& f, const E& e, S first, S last, S index)
+            {
+                typename F::accumulator_type res = f.init();
+                add_run(f, e, first, last, &res, &res, index);
+                return res;
+            }
+
+            template <class F, class E, class S, class T>
+            static void add_run(const F& f, const E& e, S first, S last, T* res, T*, S index)
+            {
+                T acc = *res;
+                for (S i = first; i < last; ++i, ++index)
+                {
+                    acc = f.reduce(acc, e.data_element(i), index);
+                }
+                *res = acc;
+            }
+
+            template <class F, class E, class S, class T>
+            static void assign(const F& f, const E& e, S first, S last, T* out, T*, S index)
+            {
+                for (S i = first; i < last; ++i, ++out)
+                {
+                    *out = f.reduce(f.init(), e.data_element(i), index);
+                }
+            }
+
+            template <class F, class E, class S, class T>
+            static void accumulate(const F& f, const E& e, S first, S last, T* out, T*, S index)
+            {
+                for (S i = first; i < last; ++i, ++out)
+                {
+                    *out = f.reduce(*out, e.data_element(i), index);
+                }
+            }
+        };
+
+        // Kernel of the reductions specified by an xreducer_functors whose
+        // accumulator is a value of the reduced expression, and whose reduce
+        // and merge functions provide simd_apply. Each lane of a batch holds
+        // a partial result, started from the initial value; the lanes are
+        // merged at the end of a run.
+        struct functors_simd_kernel
+        {
+            template <class F, class E, class S>
+            static typename F::accumulator_type run(const F& f, const E& e, S first, S last, S index)
+            {
+                typename F::accumulator_type res = f.init();
+                add_run(f, e, first, last, &res, &res, index);
+                return res;
+            }
+
+            template <class F, class E, class S, class T>
+            static void add_run(const F& f, const E& e, S first, S last, T* res, T* comp, S index)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                constexpr S block_size = 4 * batch_size;
+                if (last - first < batch_size)
+                {
+                    functors_kernel::add_run(f, e, first, last, res, comp, index);
+                    return;
+                }
+
+                batch_type acc0(f.init());
+                S i = first;
+                if (last - first >= block_size)
+                {
+                    batch_type acc1(f.init()), acc2(f.init()), acc3(f.init());
+                    S block_last = first + (last - first) / block_size * block_size;
+                    for (; i < block_last; i += block_size)
+                    {
+                        acc0 = f.simd_reduce(acc0, e.template load_batch<batch_type>(i));
+                        acc1 = f.simd_reduce(acc1, e.template load_batch<batch_type>(i + batch_size));
+                        acc2 = f.simd_reduce(acc2, e.template load_batch<batch_type>(i + 2 * batch_size));
+                        acc3 = f.simd_reduce(acc3, e.template load_batch<batch_type>(i + 3 * batch_size));
+                    }
+                    acc0 = f.simd_merge(f.simd_merge(acc0, acc1), f.simd_merge(acc2, acc3));
+                }
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                for (; i < simd_last; i += batch_size)
+                {
+                    acc0 = f.simd_reduce(acc0, e.template load_batch<batch_type>(i));
+                }
+
+                T buffer[batch_size];
+                acc0.store_unaligned(buffer);
+                T acc = *res;
+                for (S j = 0; j < batch_size; ++j)
+                {
+                    acc = f.merge(acc, buffer[j]);
+                }
+                *res = acc;
+                functors_kernel::add_run(f, e, simd_last, last, res, comp, index + (simd_last - first));
+            }
+
+            template <class F, class E, class S, class T>
+            static void assign(const F& f, const E& e, S first, S last, T* out, T* comp, S index)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                batch_type init(f.init());
+                S i = first;
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                for (; i < simd_last; i += batch_size, out += batch_size)
+                {
+                    f.simd_reduce(init, e.template load_batch<batch_type>(i)).store_unaligned(out);
+                }
+                functors_kernel::assign(f, e, i, last, out, comp, index);
+            }
+
+            template <class F, class E, class S, class T>
+            static void accumulate(const F& f, const E& e, S first, S last, T* out, T* comp, S index)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                S i = first;
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                for (; i < simd_last; i += batch_size, out += batch_size)
+                {
+                    f.simd_reduce(batch_type::load_unaligned(out), e.template load_batch<batch_type>(i)).store_unaligned(out);
+                }
+                functors_kernel::accumulate(f, e, i, last, out, comp, index);
+            }
+        };
+
+        template <class F, class E>
+        struct use_simd_functors : std::false_type
+        {
+        };
+
+        template <class R, class I, class M, class E>
+        struct use_simd_functors<xreducer_functors<R, I, M>, E>
+        {
+            using value_type = typename E::value_type;
+            using batch_type = xsimd_batch_t<value_type>;
+            static constexpr bool value = has_simd_interface<E>::value && has_simd<value_type>::value &&
+                std::is_same<typename xreducer_functors<R, I, M>::accumulator_type, value_type>::value &&
+                has_simd_apply<R, batch_type, batch_type>::value && has_simd_apply<M, batch_type, batch_type>::value;
+        };
+
+        template <class F, class E>
+        struct reducer_kernel_type
+        {
+            using type = reducer_kernel<reducer_summation<F>::value, use_simd_reduce<F, E>::value>;
+        };
+
+        template <class R, class I, class M, class E>
+        struct reducer_kernel_type<xreducer_functors<R, I, M>, E>
+        {
+            using type = std::conditional_t<use_simd_functors<xreducer_functors<R, I, M>, E>::value,
+                                            functors_simd_kernel, functors_kernel>;
+        };
+
+        /**
+         * Dimensions of a contiguous reduced expression, grouped from the
+         * innermost to the outermost into consecutive reduced or kept
+         * dimensions of extent greater than 1. The output stride of a group
+         * of reduced dimensions is 0. The index stride of a group of reduced
+         * dimensions is the stride of its position in the reduced axes,
+         * flattened in row-major order; it is 0 for the kept dimensions.
+         */
+        template <class I>
+        struct reducer_groups
+        {
+            using index_type = I;
+            using size_type = typename I::value_type;
+
+            index_type extent;
+            index_type in_stride;
+            index_type out_stride;
+            index_type index_stride;
+            size_type nb_groups;
+            size_type offset;
+        };
+
+        template <class T, class S>
+        inline T* offset_pointer(T* p, S offset) noexcept
+        {
+            return p != nullptr ? p + offset : p;
+        }
+
+        /**
+         * Reduces the data elements of e in the order of the storage,
+         * restricted to the indices [lower, upper) of the groups. The
+         * results are initialized by the first run of the reduced groups
+         * within this range. Each run of the innermost group is either
+         * folded into one result or combined element-wise with a contiguous
+         * range of results; the runs of the second group are processed in a
+         * single loop.
+         */
+        template <class K, class F, class E, class G, class T>
+        inline void reduce_box(const F& f, const E& e, const G& groups, const typename G::index_type& lower,
+                               const typename G::index_type& upper, T* out, T* comp)
+        {
+            using index_type = typename G::index_type;
+            using size_type = typename G::size_type;
+
+            size_type nb_groups = std::min(groups.nb_groups, size_type(groups.extent.size()));
+            bool reduced_run = groups.out_stride[0] == 0;
+            size_type run_size = upper[0] - lower[0];
+            size_type run_offset = reduced_run ? size_type(0) : lower[0];
+            size_type first_run = nb_groups > 1 ? lower[1] : size_type(0);
+            size_type last_run = nb_groups > 1 ? upper[1] : size_type(1);
+            size_type run_in_stride = nb_groups > 1 ? groups.in_stride[1] : size_type(0);
+            size_type run_out_stride = nb_groups > 1 ? groups.out_stride[1] : size_type(0);
+            size_type run_index_stride = nb_groups > 1 ? groups.index_stride[1] : size_type(0);
+
+            index_type index = lower;
+            size_type nb_blocks = 1;
+            size_type in_offset = groups.offset + lower[0];
+            size_type out_offset = run_offset;
+            size_type index_offset = lower[0] * groups.index_stride[0];
+            for (size_type g = 2; g < nb_groups; ++g)
+            {
+                nb_blocks *= upper[g] - lower[g];
+                in_offset += lower[g] * groups.in_stride[g];
+                out_offset += lower[g] * groups.out_stride[g];
+                index_offset += lower[g] * groups.index_stride[g];
+            }
+
+            // Number of outer reduced groups whose index is not the first one.
+            size_type nb_visited = 0;
+            for (size_type b = 0; b < nb_blocks; ++b)
+            {
+                size_type o = out_offset + first_run * run_out_stride;
+                bool init = nb_visited == 0;
+                for (size_type j = first_run; j < last_run; ++j, o += run_out_stride)
+                {
+                    size_type i = in_offset + j * run_in_stride;
+                    size_type p = index_offset + j * run_index_stride;
+                    if (reduced_run)
+                    {
+                        if (init)
+                        {
+                            out[o] = K::run(f, e, i, i + run_size, p);
+                            if (comp != nullptr)
+                            {
+                                comp[o] = T();
+                            }
+                        }
+                        else
+                        {
+                            K::add_run(f, e, i, i + run_size, out + o, offset_pointer(comp, o), p);
+                        }
+                    }
+                    else if (init)
+                    {
+                        K::assign(f, e, i, i + run_size, out + o, offset_pointer(comp, o), p);
+                    }
+                    else
+                    {
+                        K::accumulate(f, e, i, i + run_size, out + o, offset_pointer(comp, o), p);
+                    }
+                    init = init && run_out_stride != 0;
+                }
+
+                for (size_type g = 2; g < nb_groups; ++g)
+                {
+                    size_type in_stride = groups.in_stride[g];
+                    size_type out_stride = groups.out_stride[g];
+                    size_type index_stride = groups.index_stride[g];
+                    if (++index[g] != upper[g])
+                    {
+                        in_offset += in_stride;
+                        out_offset += out_stride;
+                        index_offset += index_stride;
+                        nb_visited += out_stride == 0 && index[g] == lower[g] + 1;
+                        break;
+                    }
+                    in_offset -= in_stride * (upper[g] - lower[g] - 1);
+                    out_offset -= out_stride * (upper[g] - lower[g] - 1);
+                    index_offset -= index_stride * (upper[g] - lower[g] - 1);
+                    nb_visited -= out_stride == 0 && upper[g] - lower[g] > 1;
+                    index[g] = lower[g];
+                }
+            }
+        }
+
+        // Returns the range of the offsets of the results of a box whose
+        // only restricted kept group is the outermost one.
+        template <class G>
+        inline std::pair<typename G::size_type, typename G::size_type>
+        box_output_range(const G& groups, const typename G::index_type& lower, const typename G::index_type& upper)
+        {
+            using size_type = typename G::size_type;
+            size_type first = 0;
+            size_type last = 1;
+            for (size_type g = 0; g < groups.nb_groups; ++g)
+            {
+                first += lower[g] * groups.out_stride[g];
+                last += (upper[g] - 1) * groups.out_stride[g];
+            }
+            return std::make_pair(first, last);
+        }
+
+        // Splits the outermost reduced group of the box that is not the
+        // innermost group in halves, until the box holds at most 32 runs
+        // per result. The results of the second half are computed in a
+        // buffer of the given depth and added to the ones of the first half.
+        template <class K, class F, class E, class G, class T>
+        inline void reduce_box_pairwise(const F& f, const E& e, const G& groups, typename G::index_type& lower,
+                                        typename G::index_type& upper, T* out, std::vector<uvector<T>>& buffers,
+                                        std::size_t depth)
+        {
+            using size_type = typename G::size_type;
+            constexpr size_type block_size = 32;
+
+            size_type nb_runs = 1;
+            size_type split = 0;
+            for (size_type g = 1; g < groups.nb_groups; ++g)
+            {
+                if (groups.out_stride[g] == 0)
+                {
+                    nb_runs *= upper[g] - lower[g];
+                    split = upper[g] - lower[g] > 1 ? g : split;
+                }
+            }
+            if (nb_runs <= block_size)
+            {
+                reduce_box<K>(f, e, groups, lower, upper, out, static_cast<T*>(nullptr));
+                return;
+            }
+
+            auto range = box_output_range(groups, lower, upper);
+            if (depth == buffers.size())
+            {
+                buffers.emplace_back(range.second);
+            }
+            T* tmp = buffers[depth].data();
+
+            size_type first = lower[split];
+            size_type last = upper[split];
+            size_type middle = first + (last - first) / 2;
+            upper[split] = middle;
+            reduce_box_pairwise<K>(f, e, groups, lower, upper, out, buffers, depth + 1);
+            upper[split] = last;
+            lower[split] = middle;
+            reduce_box_pairwise<K>(f, e, groups, lower, upper, tmp, buffers, depth + 1);
+            lower[split] = first;
+            for (size_type o = range.first; o < range.second; ++o)
+            {
+                out[o] = f(out[o], tmp[o]);
+            }
+        }
+
+        template <class K, class F, class E, class G, class T>
+        inline void reduce_box(const F& f, const E& e, const G& groups, const typename G::index_type& lower,
+                               const typename G::index_type& upper, T* out,
+                               std::integral_constant<summation, summation::naive>)
+        {
+            reduce_box<K>(f, e, groups, lower, upper, out, static_cast<T*>(nullptr));
+        }
+
+        template <class K, class F, class E, class G, class T>
+        inline void reduce_box(const F& f, const E& e, const G& groups, typename G::index_type& lower,
+                               typename G::index_type& upper, T* out,
+                               std::integral_constant<summation, summation::pairwise>)
+        {
+            // The depth of the recursion is bounded by the number of bits of
+            // the number of runs, the buffers are never reallocated.
+            std::vector<uvector<T>> buffers;
+            buffers.reserve(8 * sizeof(std::size_t));
+            reduce_box_pairwise<K>(f, e, groups, lower, upper, out, buffers, 0);
+        }
+
+        template <class K, class F, class E, class G, class T>
+        inline void reduce_box(const F& f, const E& e, const G& groups, const typename G::index_type& lower,
+                               const typename G::index_type& upper, T* out,
+                               std::integral_constant<summation, summation::kahan>)
+        {
+            uvector<T> comp(box_output_range(groups, lower, upper).second);
+            reduce_box<K>(f, e, groups, lower, upper, out, comp.data());
+        }
+
+        /**
+         * Reduces the data elements of e in the order of the storage,
+         * restricted to the indices [first, last) of the group split, with
+         * the summation algorithm of the functor.
+         */
+        template <class F, class E, class G, class T>
+        inline void reduce_group_range(const F& f, const E& e, const G& groups, std::size_t split,
+                                       typename G::size_type first, typename G::size_type last, T* out)
+        {
+            using index_type = typename G::index_type;
+            using size_type = typename G::size_type;
+            using summation_type = reducer_summation<F>;
+            using kernel_type = typename reducer_kernel_type<F, E>::type;
+
+            index_type lower = make_sequence<index_type>(groups.extent.size(), size_type(0));
+            index_type upper = groups.extent;
+            lower[split] = first;
+            upper[split] = last;
+            reduce_box<kernel_type>(f, e, groups, lower, upper, out, summation_type());
+        }
+
+        /**
+         * Combines the results of consecutive chunks of a reduction two by
+         * two, as soon as the results of two sequences of 2^k chunks are
+         * available. The shape of the combination tree only depends on the
+         * number of chunks, and the buffers of the combined results are
+         * reused.
+         */
+        template <class F, class T>
+        class pairwise_results
+        {
+        public:
+
+            using size_type = std::size_t;
+
+            pairwise_results(const F& f, size_type size);
+
+            T* next();
+            void push();
+            const T* finish();
+
+        private:
+
+            void combine_top();
+
+            const F& m_f;
+            size_type m_size;
+            std::vector<uvector<T>> m_stack;
+            size_type m_depth;
+            size_type m_count;
+        };
+
+        template <class F, class T>
+        inline pairwise_results<F, T>::pairwise_results(const F& f, size_type size)
+            : m_f(f), m_size(size), m_stack(), m_depth(0), m_count(0)
+        {
+        }
+
+        // Returns the buffer receiving the results of the next chunk.
+        template <class F, class T>
+        inline T* pairwise_results<F, T>::next()
+        {
+            if (m_depth == m_stack.size())
+            {
+                m_stack.emplace_back(m_size);
+            }
+            return m_stack[m_depth].data();
+        }
+
+        template <class F, class T>
+        inline void pairwise_results<F, T>::push()
+        {
+            ++m_depth;
+            ++m_count;
+            for (size_type c = m_count; c % 2 == 0; c /= 2)
+            {
+                combine_top();
+            }
+        }
+
+        template <class F, class T>
+        inline const T* pairwise_results<F, T>::finish()
+        {
+            while (m_depth > 1)
+            {
+                combine_top();
+            }
+            return m_stack[0].data();
+        }
+
+        template <class F, class T>
+        inline void pairwise_results<F, T>::combine_top()
+        {
+            T* lhs = m_stack[m_depth - 2].data();
+            const T* rhs = m_stack[m_depth - 1].data();
+            for (size_type i = 0; i < m_size; ++i)
+            {
+                lhs[i] = reducer_merge(m_f, lhs[i], rhs[i]);
+            }
+            --m_depth;
+        }
+
+        inline std::size_t ceil_power_of_two(std::size_t n) noexcept
+        {
+            std::size_t res = 1;
+            while (res < n)
+            {
+                res *= 2;
+            }
+            return res;
+        }
+
+        /**
+         * Splits the outermost group, which is reduced, into chunks whose
+         * results are computed in private buffers and combined pairwise.
+         * Each task reduces a sequence of 2^k chunks. When reductions are
+         * deterministic, the size of the chunks only depends on the size of
+         * the groups, so that the results do not depend on the number of
+         * threads.
+         */
+        template <class F, class E, class G, class T>
+        inline void reduce_partials(const F& f, const E& e, const G& groups, std::size_t out_size,
+                                    std::size_t nb_tasks, T* out)
+        {
+            using size_type = typename G::size_type;
+
+            size_type outer = groups.nb_groups - 1;
+            size_type extent = groups.extent[outer];
+            size_type chunk_extent = 0;
+            size_type chunks_per_part = 1;
+            if (deterministic_reductions())
+            {
+                size_type grain = XTENSOR_PARALLEL_GRAIN_SIZE;
+                size_type block = groups.in_stride[outer];
+                chunk_extent = std::max((grain + block - 1) / block, size_type(1));
+                size_type nb_chunks = (extent + chunk_extent - 1) / chunk_extent;
+                chunks_per_part = ceil_power_of_two((nb_chunks + nb_tasks - 1) / nb_tasks);
+            }
+            else
+            {
+                chunk_extent = (extent + nb_tasks - 1) / nb_tasks;
+            }
+            size_type nb_chunks = (extent + chunk_extent - 1) / chunk_extent;
+            size_type nb_parts = (nb_chunks + chunks_per_part - 1) / chunks_per_part;
+
+            std::vector<pairwise_results<F, T>> parts(nb_parts, pairwise_results<F, T>(f, out_size));
+            parallel_for_each_chunk(nb_parts, [&](std::size_t p) {
+                size_type last_chunk = std::min(nb_chunks, (p + 1) * chunks_per_part);
+                for (size_type c = p * chunks_per_part; c < last_chunk; ++c)
+                {
+                    reduce_group_range(f, e, groups, outer, c * chunk_extent, std::min(extent, (c + 1) * chunk_extent), parts[p].next());
+                    parts[p].push();
+                }
+            });
+
+            pairwise_results<F, T> results(f, out_size);
+            for (auto& part : parts)
+            {
+                const T* part_results = part.finish();
+                std::copy(part_results, part_results + out_size, results.next());
+                results.push();
+            }
+            const T* res = results.finish();
+            std::copy(res, res + out_size, out);
+        }
+
+        /**
+         * Reduces the data elements of e in the order of the storage into
+         * the out_size results pointed to by out, possibly in parallel.
+         * When the outermost group is reduced and the results are few, the
+         * reduced extent is split among the tasks; otherwise, the outermost
+         * kept group that can be split among all the tasks is, so that each
+         * result is computed by a single task. The summation algorithms
+         * other than the naive one require the outermost kept group to be
+         * split.
+         */
+        template <class F, class E, class G, class T>
+        inline void reduce_in_storage_order(const F& f, const E& e, const G& groups, std::size_t out_size, T* out)
+        {
+            using size_type = typename G::size_type;
+            if (groups.nb_groups == 0)
+            {
+                *out = reduce_element(f, e, groups.offset);
+                return;
+            }
+
+            size_type outer = groups.nb_groups - 1;
+            size_type size = groups.in_stride[outer] * groups.extent[outer];
+            size_type nb_tasks = parallel_chunk_count(size, XTENSOR_PARALLEL_GRAIN_SIZE);
+            bool outer_reduced = groups.out_stride[outer] == 0;
+            bool split_reduced = nb_tasks > 1 || (deterministic_reductions() && size > XTENSOR_PARALLEL_GRAIN_SIZE);
+            if (outer_reduced && out_size <= XTENSOR_PARALLEL_GRAIN_SIZE && split_reduced)
+            {
+                reduce_partials(f, e, groups, out_size, nb_tasks, out);
+            }
+            else if (nb_tasks > 1)
+            {
+                size_type split = outer + 1;
+                for (size_type g = outer + 1; g != 0; --g)
+                {
+                    if (groups.out_stride[g - 1] != 0 && (split > outer || groups.extent[g - 1] > groups.extent[split]))
+                    {
+                        split = g - 1;
+                        if (groups.extent[split] >= nb_tasks || reducer_summation<F>::value != summation::naive)
+                        {
+                            break;
+                        }
+                    }
+                }
+                size_type extent = groups.extent[split];
+                size_type nb_chunks = std::min(nb_tasks, extent);
+                parallel_for_each_chunk(nb_chunks, [&](std::size_t i) {
+                    reduce_group_range(f, e, groups, split, extent * i / nb_chunks, extent * (i + 1) / nb_chunks, out);
+                });
+            }
+            else
+            {
+                reduce_group_range(f, e, groups, outer, size_type(0), groups.extent[outer], out);
+            }
+        }
+
+        // Returns the storage of e when the results can be computed in
+        // place, and the buffer resized to the size of e otherwise.
+        template <class T, class E>
+        inline T* reducer_output(E& e, layout_type l, uvector<T>& buffer, std::true_type /*same value type*/)
+        {
+            if (e.layout() == l || e.dimension() <= 1)
+            {
+                return &e.data_element(0);
+            }
+            buffer.resize(e.size());
+            return buffer.data();
+        }
+
+        template <class T, class E>
+        inline T* reducer_output(E& e, layout_type, uvector<T>& buffer, std::false_type /*same value type*/)
+        {
+            buffer.resize(e.size());
+            return buffer.data();
+        }
+    }
+
+    /***************************
+     * xreducer implementation *
+     ***************************/
+
+    /**
+     * @name Constructor
+     */
+    //@{
+    /**
+     * Constructs an xreducer expression applying the specified
+     * function to the given expression over the given axes.
+     *
+     * @param func the function to apply
      * @param e the expression to reduce
      * @param axes the axes along which the reduction is performed
      */
@@ -330,7 +1949,7 @@ namespace xt
           m_shape(make_sequence<shape_type>(m_e.dimension() - m_axes.size(), 0)),
           m_dim_mapping(make_sequence<shape_type>(m_e.dimension() - m_axes.size(), 0))
     {
-        if (!std::is_sorted(m_axes.cbegin(), m_axes.cend()))
+        if (!detail::is_xaxes<axes_type>::value && !std::is_sorted(m_axes.cbegin(), m_axes.cend()))
         {
             throw std::runtime_error("Reducing axes should be sorted");
         }
@@ -426,13 +2045,7 @@ namespace xt
     template <class It>
     inline auto xreducer<F, CT, X>::element(It first, It last) const -> const_reference
     {
-        auto stepper = const_stepper(*this, 0);
-        size_type dim = 0;
-        while (first != last)
-        {
-            stepper.step(dim++, *first++);
-        }
-        return *stepper;
+        return element_impl(first, last, std::integral_constant<bool, xexpression_type::contiguous_layout>());
     }
     //@}
 
@@ -463,23 +2076,307 @@ namespace xt
     {
         return false;
     }
+
+    /**
+     * Calls \c f with the range of memory of the reduced expression.
+     * @return false if the memory of the reduced expression is unknown
+     * @sa visit_memory
+     */
+    template <class F, class CT, class X>
+    template <class Func>
+    inline bool xreducer<F, CT, X>::visit_memory(Func&& f) const
+    {
+        return xt::visit_memory(m_e, f);
+    }
     //@}
 
+    /**
+     * @name Steppers
+     */
+    //@{
+    /**
+     * Returns a stepper on the reducer broadcast to \c shape. A stepper
+     * computes the value it points to on each dereference. When \c shape
+     * is bigger than the shape of the reducer, each value would be computed
+     * several times: the reducer is then evaluated once into a buffer shared
+     * by all the steppers created for the same traversal, and freed with them.
+     * @param shape the shape of the traversal
+     */
     template <class F, class CT, class X>
     template <class S>
-    inline auto xreducer<F, CT, X>::stepper_begin(const S& shape) const noexcept -> const_stepper
+    inline auto xreducer<F, CT, X>::stepper_begin(const S& shape) const -> const_stepper
     {
+        if (std::shared_ptr<const cache_type> cache = broadcast_cache(shape))
+        {
+            typename const_stepper::cache_stepper st(cache.get(), cache->data_xbegin(), shape.size() - dimension());
+            return const_stepper(*this, std::move(cache), st);
+        }
         size_type offset = shape.size() - dimension();
         return const_stepper(*this, offset);
     }
 
     template <class F, class CT, class X>
     template <class S>
-    inline auto xreducer<F, CT, X>::stepper_end(const S& shape, layout_type l) const noexcept -> const_stepper
+    inline auto xreducer<F, CT, X>::stepper_end(const S& shape, layout_type l) const -> const_stepper
     {
+        if (std::shared_ptr<const cache_type> cache = broadcast_cache(shape))
+        {
+            typename const_stepper::cache_stepper st(cache.get(), cache->data_xend(l), shape.size() - dimension());
+            return const_stepper(*this, std::move(cache), st);
+        }
         size_type offset = shape.size() - dimension();
         return const_stepper(*this, offset, true, l);
     }
+    //@}
+
+    /**
+     * Assigns the result of the reduction to the container \c e, which is
+     * reshaped to the shape of the reducer. When the reduced axes are the
+     * innermost axes of the reduced expression, each result is computed
+     * from a contiguous range of its data elements.
+     * @param e the container to assign.
+     */
+    template <class F, class CT, class X>
+    template <class E>
+    inline void xreducer<F, CT, X>::assign_to(xexpression<E>& e) const
+    {
+        xt::reshape(e, *this);
+        if (!assign_contiguous(e.derived_cast(), std::integral_constant<bool, xexpression_type::contiguous_layout>()))
+        {
+            xt::assign_data(e, *this, false);
+        }
+    }
+
+    template <class F, class CT, class X>
+    template <class S>
+    inline auto xreducer<F, CT, X>::broadcast_cache(const S& shape) const -> std::shared_ptr<const cache_type>
+    {
+        std::shared_ptr<const cache_type> cache = m_cache.lock();
+        if (!cache && compute_size(shape) > size())
+        {
+            cache = std::make_shared<const cache_type>(*this);
+            m_cache = cache;
+        }
+        return cache;
+    }
+
+    template <class F, class CT, class X>
+    template <class It>
+    inline auto xreducer<F, CT, X>::element_impl(It first, It last, std::true_type) const -> const_reference
+    {
+        strides_type strides = make_sequence<strides_type>(m_e.dimension(), size_type(0));
+        layout_type l = contiguous_reduction_layout(strides);
+        if (l == layout_type::dynamic || (l == layout_type::column_major && uses_index::value))
+        {
+            return element_impl(first, last, std::false_type());
+        }
+
+        size_type nb_indices = static_cast<size_type>(std::distance(first, last));
+        if (nb_indices > dimension())
+        {
+            std::advance(first, nb_indices - dimension());
+        }
+        size_type offset = 0;
+        for (size_type dim = 0; first != last; ++dim, ++first)
+        {
+            offset += static_cast<size_type>(*first) * strides[m_dim_mapping[dim]];
+        }
+        size_type size = reduced_size();
+        if (size == 1)
+        {
+            return detail::reduce_element(m_f, m_e, offset);
+        }
+
+        using index_type = xindex_type_t<strides_type>;
+        detail::reducer_groups<index_type> groups;
+        groups.extent = make_sequence<index_type>(m_e.dimension(), size_type(1));
+        groups.in_stride = make_sequence<index_type>(m_e.dimension(), size_type(1));
+        groups.out_stride = make_sequence<index_type>(m_e.dimension(), size_type(0));
+        groups.index_stride = make_sequence<index_type>(m_e.dimension(), size_type(1));
+        groups.extent[0] = size;
+        groups.nb_groups = 1;
+        groups.offset = offset;
+        value_type res = value_type();
+        detail::reduce_in_storage_order(m_f, m_e, groups, 1, &res);
+        return res;
+    }
+
+    template <class F, class CT, class X>
+    template <class It>
+    inline auto xreducer<F, CT, X>::element_impl(It first, It last, std::false_type) const -> const_reference
+    {
+        auto stepper = const_stepper(*this, 0);
+        size_type dim = 0;
+        while (first != last)
+        {
+            stepper.step(dim++, *first++);
+        }
+        return *stepper;
+    }
+
+    // The data elements of the reduced expression are read in the order
+    // of the storage and accumulated into the results, whatever the
+    // reduced axes. Reductions needing the positions of the elements are
+    // only computed this way in row-major order.
+    template <class F, class CT, class X>
+    template <class E>
+    inline bool xreducer<F, CT, X>::assign_contiguous(E& e, std::true_type) const
+    {
+        using index_type = xindex_type_t<strides_type>;
+
+        strides_type strides = make_sequence<strides_type>(m_e.dimension(), size_type(0));
+        layout_type l = storage_layout(strides);
+        if (l == layout_type::dynamic || reduced_size() == 0 || (l == layout_type::column_major && uses_index::value))
+        {
+            return false;
+        }
+        size_type size = compute_size(m_shape);
+        if (size == 0)
+        {
+            return true;
+        }
+
+        size_type dim = m_e.dimension();
+        detail::reducer_groups<index_type> groups;
+        groups.extent = make_sequence<index_type>(dim, size_type(1));
+        groups.in_stride = make_sequence<index_type>(dim, size_type(0));
+        groups.out_stride = make_sequence<index_type>(dim, size_type(0));
+        groups.index_stride = make_sequence<index_type>(dim, size_type(0));
+        groups.nb_groups = 0;
+        groups.offset = 0;
+        size_type in_size = 1;
+        size_type out_size = 1;
+        size_type index_size = 1;
+        for (size_type r = 0; r < dim; ++r)
+        {
+            size_type d = l == layout_type::column_major ? r : dim - 1 - r;
+            size_type extent = m_e.shape()[d];
+            if (extent == 1)
+            {
+                continue;
+            }
+            bool reduced = is_reduced_axis(d);
+            size_type g = groups.nb_groups;
+            if (g != 0 && (groups.out_stride[g - 1] == 0) == reduced)
+            {
+                groups.extent[g - 1] *= extent;
+            }
+            else
+            {
+                groups.extent[g] = extent;
+                groups.in_stride[g] = in_size;
+                groups.out_stride[g] = reduced ? 0 : out_size;
+                groups.index_stride[g] = reduced ? index_size : 0;
+                ++groups.nb_groups;
+            }
+            in_size *= extent;
+            if (reduced)
+            {
+                index_size *= extent;
+            }
+            else
+            {
+                out_size *= extent;
+            }
+        }
+
+        uvector<value_type> buffer;
+        value_type* out = detail::reducer_output(e, l, buffer, std::is_same<typename E::value_type, value_type>());
+        detail::reduce_in_storage_order(m_f, m_e, groups, size, out);
+        if (!buffer.empty())
+        {
+            if (e.layout() == l || e.dimension() <= 1)
+            {
+                std::copy(buffer.cbegin(), buffer.cend(), e.storage_begin());
+            }
+            else if (l == layout_type::row_major)
+            {
+                std::copy(buffer.cbegin(), buffer.cend(), e.template begin<layout_type::row_major>());
+            }
+            else
+            {
+                std::copy(buffer.cbegin(), buffer.cend(), e.template begin<layout_type::column_major>());
+            }
+        }
+        return true;
+    }
+
+    template <class F, class CT, class X>
+    template <class E>
+    inline bool xreducer<F, CT, X>::assign_contiguous(E&, std::false_type) const
+    {
+        return false;
+    }
+
+    // Returns the layout in which the data elements of the reduced
+    // expression are stored contiguously, in which case strides holds the
+    // strides of this layout. Returns layout_type::dynamic otherwise.
+    template <class F, class CT, class X>
+    inline layout_type xreducer<F, CT, X>::storage_layout(strides_type& strides) const
+    {
+        compute_strides(m_e.shape(), layout_type::row_major, strides);
+        if (m_e.is_trivial_broadcast(strides))
+        {
+            return layout_type::row_major;
+        }
+        compute_strides(m_e.shape(), layout_type::column_major, strides);
+        if (m_e.is_trivial_broadcast(strides))
+        {
+            return layout_type::column_major;
+        }
+        return layout_type::dynamic;
+    }
+
+    // Returns the storage layout of the reduced expression if the reduced
+    // axes are its innermost axes in this layout: each result is then the
+    // reduction of a contiguous range of data elements. Returns
+    // layout_type::dynamic otherwise, or when one of the reduced axes is
+    // empty.
+    template <class F, class CT, class X>
+    inline layout_type xreducer<F, CT, X>::contiguous_reduction_layout(strides_type& strides) const
+    {
+        size_type dim = m_e.dimension();
+        size_type nb_axes = m_axes.size();
+        if (reduced_size() == 0)
+        {
+            return layout_type::dynamic;
+        }
+
+        bool leading = true;
+        bool trailing = true;
+        for (size_type i = 0; i < nb_axes; ++i)
+        {
+            leading = leading && size_type(m_axes[i]) == i;
+            trailing = trailing && size_type(m_axes[i]) == dim - nb_axes + i;
+        }
+        layout_type l = storage_layout(strides);
+        bool innermost = (l == layout_type::row_major && trailing) || (l == layout_type::column_major && leading);
+        return innermost ? l : layout_type::dynamic;
+    }
+
+    template <class F, class CT, class X>
+    inline auto xreducer<F, CT, X>::reduced_size() const noexcept -> size_type
+    {
+        size_type res = 1;
+        for (size_type i = 0; i < m_axes.size(); ++i)
+        {
+            res *= m_e.shape()[m_axes[i]];
+        }
+        return res;
+    }
+
+    template <class F, class CT, class X>
+    inline bool xreducer<F, CT, X>::is_reduced_axis(size_type d) const noexcept
+    {
+        for (size_type i = 0; i < m_axes.size(); ++i)
+        {
+            if (size_type(m_axes[i]) == d)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
 
     /***********************************
      * xreducer_stepper implementation *
@@ -488,7 +2385,7 @@ namespace xt
     template <class F, class CT, class X>
     inline xreducer_stepper<F, CT, X>::xreducer_stepper(const xreducer_type& red, size_type offset, bool end, layout_type l)
         : m_reducer(red), m_offset(offset),
-          m_stepper(get_substepper_begin())
+          m_stepper(get_substepper_begin()), m_cache(), m_cache_stepper()
     {
         if (end)
         {
@@ -496,17 +2393,28 @@ namespace xt
         }
     }
 
+    // Stepper reading the values of the reducer from the evaluated cache
+    template <class F, class CT, class X>
+    inline xreducer_stepper<F, CT, X>::xreducer_stepper(const xreducer_type& red, std::shared_ptr<const cache_type> cache, cache_stepper st)
+        : m_reducer(red), m_offset(0),
+          m_stepper(get_substepper_begin()), m_cache(std::move(cache)), m_cache_stepper(st)
+    {
+    }
+
     template <class F, class CT, class X>
     inline auto xreducer_stepper<F, CT, X>::operator*() const -> reference
     {
-        reference r = aggregate(0);
-        return r;
+        return m_cache ? *m_cache_stepper : dereference(functors_type());
     }
 
     template <class F, class CT, class X>
     inline void xreducer_stepper<F, CT, X>::step(size_type dim, size_type n)
     {
-        if (dim >= m_offset)
+        if (m_cache)
+        {
+            m_cache_stepper.step(dim, n);
+        }
+        else if (dim >= m_offset)
         {
             m_stepper.step(get_dim(dim), n);
         }
@@ -515,7 +2423,11 @@ namespace xt
     template <class F, class CT, class X>
     inline void xreducer_stepper<F, CT, X>::step_back(size_type dim, size_type n)
     {
-        if (dim >= m_offset)
+        if (m_cache)
+        {
+            m_cache_stepper.step_back(dim, n);
+        }
+        else if (dim >= m_offset)
         {
             m_stepper.step_back(get_dim(dim), n);
         }
@@ -524,7 +2436,11 @@ namespace xt
     template <class F, class CT, class X>
     inline void xreducer_stepper<F, CT, X>::reset(size_type dim)
     {
-        if (dim >= m_offset)
+        if (m_cache)
+        {
+            m_cache_stepper.reset(dim);
+        }
+        else if (dim >= m_offset)
         {
             m_stepper.reset(get_dim(dim));
         }
@@ -533,7 +2449,11 @@ namespace xt
     template <class F, class CT, class X>
     inline void xreducer_stepper<F, CT, X>::reset_back(size_type dim)
     {
-        if (dim >= m_offset)
+        if (m_cache)
+        {
+            m_cache_stepper.reset_back(dim);
+        }
+        else if (dim >= m_offset)
         {
             m_stepper.reset_back(get_dim(dim));
         }
@@ -542,23 +2462,144 @@ namespace xt
     template <class F, class CT, class X>
     inline void xreducer_stepper<F, CT, X>::to_begin()
     {
-        m_stepper.to_begin();
+        if (m_cache)
+        {
+            m_cache_stepper.to_begin();
+        }
+        else
+        {
+            m_stepper.to_begin();
+        }
     }
 
     template <class F, class CT, class X>
     inline void xreducer_stepper<F, CT, X>::to_end(layout_type l)
     {
-        m_stepper.to_end(l);
+        if (m_cache)
+        {
+            m_cache_stepper.to_end(l);
+        }
+        else
+        {
+            m_stepper.to_end(l);
+        }
     }
 
     template <class F, class CT, class X>
     inline bool xreducer_stepper<F, CT, X>::equal(const self_type& rhs) const
     {
-        return &m_reducer == &(rhs.m_reducer) && m_stepper.equal(rhs.m_stepper);
+        return &m_reducer == &(rhs.m_reducer) && m_cache == rhs.m_cache &&
+            (m_cache ? m_cache_stepper.equal(rhs.m_cache_stepper) : m_stepper.equal(rhs.m_stepper));
+    }
+
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::dereference(std::false_type) const -> reference
+    {
+        return aggregate_root(fixed_axes());
+    }
+
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::dereference(std::true_type) const -> reference
+    {
+        const auto& f = m_reducer.m_f;
+        if (m_reducer.m_axes.size() == 0)
+        {
+            return f.reduce(f.init(), *m_stepper, 0);
+        }
+        reference acc = f.init();
+        fold(0, acc, 0);
+        return acc;
+    }
+
+    // Folds the elements of the reduced axes dim and the following ones
+    // into acc, index is the position of the first one.
+    template <class F, class CT, class X>
+    inline void xreducer_stepper<F, CT, X>::fold(size_type dim, reference& acc, size_type index) const
+    {
+        size_type nb_axes = m_reducer.m_axes.size();
+        size_type axis_index = axis(dim);
+        size_type size = shape(axis_index);
+        if (size == 0)
+        {
+            return;
+        }
+        size_type stride = 1;
+        for (size_type d = dim + 1; d < nb_axes; ++d)
+        {
+            stride *= shape(axis(d));
+        }
+        for (size_type i = 0; i != size; ++i, index += stride)
+        {
+            if (i != 0)
+            {
+                m_stepper.step(axis_index);
+            }
+            if (dim == nb_axes - 1)
+            {
+                acc = m_reducer.m_f.reduce(acc, *m_stepper, index);
+            }
+            else
+            {
+                fold(dim + 1, acc, index);
+            }
+        }
+        m_stepper.reset(axis_index);
+    }
+
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::aggregate_root(std::false_type) const -> reference
+    {
+        reference r = aggregate(0);
+        return r;
+    }
+
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::aggregate_root(std::true_type) const -> reference
+    {
+        return aggregate_fixed(std::integral_constant<std::size_t, 0>());
+    }
+
+    // Naive aggregation over axes known at compile time: the nesting of
+    // the loops is unrolled, and the innermost loop can be vectorized.
+    template <class F, class CT, class X>
+    template <std::size_t D>
+    inline auto xreducer_stepper<F, CT, X>::aggregate_fixed(std::integral_constant<std::size_t, D> d) const -> reference
+    {
+        constexpr size_type index = axes_type::values[D];
+        using is_last = std::integral_constant<bool, D + 1 == axes_type::size()>;
+        size_type size = shape(index);
+        reference res = aggregate_fixed_inner(d, is_last());
+        for (size_type i = 1; i != size; ++i)
+        {
+            m_stepper.step(index);
+            res = m_reducer.m_f(res, aggregate_fixed_inner(d, is_last()));
+        }
+        m_stepper.reset(index);
+        return res;
+    }
+
+    template <class F, class CT, class X>
+    template <std::size_t D>
+    inline auto xreducer_stepper<F, CT, X>::aggregate_fixed_inner(std::integral_constant<std::size_t, D>, std::false_type) const -> reference
+    {
+        return aggregate_fixed(std::integral_constant<std::size_t, D + 1>());
+    }
+
+    template <class F, class CT, class X>
+    template <std::size_t D>
+    inline auto xreducer_stepper<F, CT, X>::aggregate_fixed_inner(std::integral_constant<std::size_t, D>, std::true_type) const -> reference
+    {
+        return *m_stepper;
     }
 
     template <class F, class CT, class X>
     inline auto xreducer_stepper<F, CT, X>::aggregate(size_type dim) const -> reference
+    {
+        return aggregate(dim, summation_type());
+    }
+
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::aggregate(size_type dim, std::integral_constant<summation, summation::naive>) const -> reference
     {
         size_type index = axis(dim);
         size_type size = shape(index);
@@ -585,6 +2626,60 @@ namespace xt
         return res;
     }
 
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::aggregate(size_type dim, std::integral_constant<summation, summation::pairwise>) const -> reference
+    {
+        size_type index = axis(dim);
+        reference res = aggregate_range(dim, shape(index));
+        m_stepper.reset(index);
+        return res;
+    }
+
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::aggregate(size_type dim, std::integral_constant<summation, summation::kahan>) const -> reference
+    {
+        size_type index = axis(dim);
+        size_type size = shape(index);
+        reference res = aggregate_inner(dim);
+        reference comp = reference(0);
+        for (size_type i = 1; i != size; ++i)
+        {
+            m_stepper.step(index);
+            detail::kahan_add(res, comp, aggregate_inner(dim));
+        }
+        m_stepper.reset(index);
+        return res;
+    }
+
+    // Aggregates the next size slices along the reduced axis dim, the
+    // stepper is left on the last one.
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::aggregate_range(size_type dim, size_type size) const -> reference
+    {
+        size_type index = axis(dim);
+        if (size > 16)
+        {
+            size_type half = size / 2;
+            reference res = aggregate_range(dim, half);
+            m_stepper.step(index);
+            return m_reducer.m_f(res, aggregate_range(dim, size - half));
+        }
+        reference res = aggregate_inner(dim);
+        for (size_type i = 1; i != size; ++i)
+        {
+            m_stepper.step(index);
+            res = m_reducer.m_f(res, aggregate_inner(dim));
+        }
+        return res;
+    }
+
+    // Aggregates the current slice along the reduced axis dim.
+    template <class F, class CT, class X>
+    inline auto xreducer_stepper<F, CT, X>::aggregate_inner(size_type dim) const -> reference
+    {
+        return dim != m_reducer.m_axes.size() - 1 ? aggregate(dim + 1) : reference(*m_stepper);
+    }
+
     template <class F, class CT, class X>
     inline auto xreducer_stepper<F, CT, X>::get_substepper_begin() const -> substepper_type
     {
@@ -594,7 +2689,7 @@ namespace xt
     template <class F, class CT, class X>
     inline auto xreducer_stepper<F, CT, X>::get_dim(size_type dim) const noexcept -> size_type
     {
-        return m_reducer.m_dim_mapping[dim];
+        return m_reducer.m_dim_mapping[dim - m_offset];
     }
 
     template <class F, class CT, class X>
@@ -11,8 +11,10 @@
 
 #include <array>
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
+#include "xbatch.hpp"
 #include "xexpression.hpp"
 #include "xiterable.hpp"
 #include "xlayout.hpp"
@@ -98,6 +100,7 @@ namespace xt
 
         static constexpr layout_type static_layout = layout_type::any;
         static constexpr bool contiguous_layout = true;
+        static constexpr bool simd_interface = std::is_arithmetic<value_type>::value;
 
         xscalar(CT value) noexcept;
 
@@ -128,6 +131,12 @@ namespace xt
         template <class S>
         bool is_trivial_broadcast(const S& strides) const noexcept;
 
+        template <class F>
+        bool visit_strides(F&& f) const noexcept;
+
+        template <class F>
+        bool visit_memory(F&& f) const;
+
         template <layout_type L = DL>
         iterator begin() noexcept;
         template <layout_type L = DL>
@@ -232,6 +241,9 @@ namespace xt
         reference data_element(size_type i) noexcept;
         const_reference data_element(size_type i) const noexcept;
 
+        template <class B, class Mode = unaligned_mode>
+        B load_batch(size_type i) const noexcept;
+
     private:
 
         CT m_value;
@@ -247,6 +259,16 @@ namespace xt
     template <class T>
     xscalar<const T&> xcref(T& t);
 
+    template <class E>
+    struct is_xscalar : std::false_type
+    {
+    };
+
+    template <class CT>
+    struct is_xscalar<xscalar<CT>> : std::true_type
+    {
+    };
+
     /*******************
      * xscalar_stepper *
      *******************/
@@ -476,6 +498,30 @@ namespace xt
         return true;
     }
 
+    template <class CT>
+    template <class F>
+    inline bool xscalar<CT>::visit_strides(F&&) const noexcept
+    {
+        return true;
+    }
+
+    /**
+     * Calls \c f with the address of the value if the scalar holds a
+     * reference (see xref and xcref); does nothing otherwise.
+     * @return true
+     */
+    template <class CT>
+    template <class F>
+    inline bool xscalar<CT>::visit_memory(F&& f) const
+    {
+        if (std::is_reference<CT>::value)
+        {
+            const value_type* value = &m_value;
+            f(static_cast<const void*>(value), static_cast<const void*>(value + 1));
+        }
+        return true;
+    }
+
     template <class CT>
     template <layout_type L>
     inline auto xscalar<CT>::begin() noexcept -> iterator
@@ -796,6 +842,13 @@ namespace xt
         return m_value;
     }
 
+    template <class CT>
+    template <class B, class Mode>
+    inline B xscalar<CT>::load_batch(size_type) const noexcept
+    {
+        return B(static_cast<typename B::value_type>(m_value));
+    }
+
     template <class T>
     inline xscalar<T&> xref(T& t)
     {
@@ -405,12 +405,37 @@ namespace xt
         return this->derived_cast().computed_assign(this->derived_cast() / e.derived_cast());
     }
 
+    /**
+     * Assigns the xexpression \c e to \c *this. The expression is first
+     * evaluated into a temporary unless the memory it reads is known
+     * not to overlap the memory of \c *this.
+     * @param e the xexpression to assign.
+     * @return a reference to \c *this.
+     * @sa may_alias
+     */
     template <class D>
     template <class E>
     inline auto xsemantic_base<D>::operator=(const xexpression<E>& e) -> derived_type&
     {
-        temporary_type tmp(e);
-        return this->derived_cast().assign_temporary(std::move(tmp));
+        bool assigned = static_if<has_memory_visitor<D>::value>([&](auto self)
+        {
+            if (may_alias(self(this->derived_cast()), e.derived_cast()))
+            {
+                return false;
+            }
+            self(this->derived_cast()).assign_xexpression(e);
+            return true;
+        }, /*else*/ [](auto)
+        {
+            return false;
+        });
+
+        if (!assigned)
+        {
+            temporary_type tmp(e);
+            this->derived_cast().assign_temporary(std::move(tmp));
+        }
+        return this->derived_cast();
     }
 
     /**************************************
@@ -497,7 +522,7 @@ namespace xt
     template <class E, class F>
     inline auto xadaptor_semantic<D>::scalar_computed_assign(const E& e, F&& f) -> derived_type&
     {
-        xt::scalar_computed_assign(this, e, std::forward<F>(f));
+        xt::scalar_computed_assign(*this, e, std::forward<F>(f));
         return this->derived_cast();
     }
 
@@ -546,9 +571,7 @@ namespace xt
     template <class E, class F>
     inline auto xview_semantic<D>::scalar_computed_assign(const E& e, F&& f) -> derived_type&
     {
-        D& d = this->derived_cast();
-        std::transform(d.begin(), d.end(), d.begin(),
-                       [e, &f](const auto& v) { return f(v, e); });
+        xt::scalar_computed_assign(*this, e, std::forward<F>(f));
         return this->derived_cast();
     }
 
@@ -0,0 +1,535 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XSORT_HPP
+#define XSORT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xarray.hpp"
+#include "xexpression.hpp"
+#include "xparallel.hpp"
+#include "xstorage.hpp"
+#include "xtensor.hpp"
+#include "xutils.hpp"
+
+namespace xt
+{
+
+    namespace detail
+    {
+        template <class E, class T, layout_type L, bool = is_array<typename E::shape_type>::value>
+        struct sort_result
+        {
+            using type = xarray<T, L>;
+        };
+
+        template <class E, class T, layout_type L>
+        struct sort_result<E, T, L, true>
+        {
+            using type = xtensor<T, std::tuple_size<typename E::shape_type>::value, L>;
+        };
+
+        template <class E, class T, layout_type L = DEFAULT_LAYOUT>
+        using sort_result_t = typename sort_result<E, T, L>::type;
+
+        template <class T>
+        using percentile_value_type_t = std::conditional_t<std::is_integral<T>::value, double, T>;
+    }
+
+    /*********************
+     * sorting functions *
+     *********************/
+
+    template <class E>
+    void sort_in_place(xexpression<E>& e, std::size_t axis);
+
+    template <class E>
+    auto sort(const xexpression<E>& e, std::size_t axis);
+
+    template <class E>
+    auto argsort(const xexpression<E>& e, std::size_t axis);
+
+    template <class E>
+    auto partition(const xexpression<E>& e, std::size_t kth, std::size_t axis);
+
+    template <class E>
+    auto argpartition(const xexpression<E>& e, std::size_t kth, std::size_t axis);
+
+    template <class E>
+    auto percentile(const xexpression<E>& e, double q, std::size_t axis);
+
+    template <class E>
+    auto percentile(const xexpression<E>& e, double q);
+
+    template <class E>
+    auto median(const xexpression<E>& e, std::size_t axis);
+
+    template <class E>
+    auto median(const xexpression<E>& e);
+
+    template <class E>
+    auto topk(const xexpression<E>& e, std::size_t k, std::size_t axis);
+
+    /************************************
+     * sorting functions implementation *
+     ************************************/
+
+    namespace detail
+    {
+        // Calls f(first, last, l) on each line l of p, in parallel across
+        // lines. Lines that are not contiguous are gathered into a scratch
+        // buffer and written back after the call. f is copied for each chunk
+        // of lines, so it may own scratch buffers of its own.
+        template <class T, class F>
+        inline void for_each_line(T* p, const line_geometry& g, const F& f)
+        {
+            if (g.n == 0 || g.size() == 0)
+            {
+                return;
+            }
+            std::size_t grain = std::max(XTENSOR_PARALLEL_GRAIN_SIZE / g.n, std::size_t(1));
+            parallel_for(g.size(), grain, [&f, p, g](std::size_t first, std::size_t last) {
+                F func = f;
+                uvector<T> line(g.inner == 1 ? 0 : g.n);
+                for (std::size_t l = first; l < last; ++l)
+                {
+                    T* base = p + g.line_offset(l);
+                    if (g.inner == 1)
+                    {
+                        func(base, base + g.n, l);
+                    }
+                    else
+                    {
+                        for (std::size_t k = 0; k < g.n; ++k)
+                        {
+                            line[k] = base[k * g.inner];
+                        }
+                        func(line.data(), line.data() + g.n, l);
+                        for (std::size_t k = 0; k < g.n; ++k)
+                        {
+                            base[k * g.inner] = line[k];
+                        }
+                    }
+                }
+            });
+        }
+
+        // Calls f on the lines of the container c along axis, in place when
+        // the storage of c is row-major or column-major.
+        template <class E, class F>
+        inline void apply_along_axis(E& c, std::size_t axis, const F& f)
+        {
+            using value_type = typename E::value_type;
+            if (axis >= c.dimension())
+            {
+                throw std::out_of_range("Sorting axis out of bounds");
+            }
+            if (c.size() == 0)
+            {
+                return;
+            }
+            layout_type l = c.layout();
+            if (l == layout_type::row_major || l == layout_type::column_major || c.dimension() == 1)
+            {
+                for_each_line(&c.data_element(0), make_line_geometry(c.shape(), axis, l), f);
+            }
+            else
+            {
+                uvector<value_type> buffer(c.size());
+                std::copy(c.template cbegin<layout_type::row_major>(), c.template cend<layout_type::row_major>(), buffer.begin());
+                for_each_line(buffer.data(), make_line_geometry(c.shape(), axis, layout_type::row_major), f);
+                std::copy(buffer.cbegin(), buffer.cend(), c.template begin<layout_type::row_major>());
+            }
+        }
+
+        template <class C>
+        inline void check_kth(const C& c, std::size_t kth, std::size_t axis)
+        {
+            if (axis >= c.dimension())
+            {
+                throw std::out_of_range("Sorting axis out of bounds");
+            }
+            if (kth >= c.shape()[axis])
+            {
+                throw std::out_of_range("Partition index out of bounds");
+            }
+        }
+
+        template <class E, class F>
+        inline auto arg_along_axis(const E& e, std::size_t axis, const F& select)
+        {
+            using value_type = typename E::value_type;
+            sort_result_t<E, value_type> values = e;
+            auto res = sort_result_t<E, std::size_t>::from_shape(values.shape());
+            if (values.size() == 0)
+            {
+                return res;
+            }
+            line_geometry g = make_line_geometry(values.shape(), axis, values.layout());
+            std::size_t* out = &res.data_element(0);
+            for_each_line(&values.data_element(0), g,
+                          [&select, out, g, idx = uvector<std::size_t>(g.n)](value_type* first, value_type*, std::size_t l) mutable {
+                              // Ties are ordered by index, so that the result
+                              // does not depend on the selection algorithm.
+                              std::iota(idx.begin(), idx.end(), std::size_t(0));
+                              select(idx.begin(), idx.end(), [first](std::size_t i, std::size_t j) {
+                                  return first[i] < first[j] || (!(first[j] < first[i]) && i < j);
+                              });
+                              std::size_t* o = out + g.line_offset(l);
+                              for (std::size_t k = 0; k < g.n; ++k)
+                              {
+                                  o[k * g.inner] = idx[k];
+                              }
+                          });
+            return res;
+        }
+
+        // Linear interpolation between the closest ranks, the line being
+        // partially reordered.
+        template <class R, class T>
+        inline R percentile_line(T* first, T* last, double q)
+        {
+            std::size_t n = std::size_t(last - first);
+            if (n == 0)
+            {
+                return std::numeric_limits<R>::quiet_NaN();
+            }
+            double pos = q / 100. * double(n - 1);
+            std::size_t lo = std::size_t(std::floor(pos));
+            std::nth_element(first, first + std::ptrdiff_t(lo), last);
+            R low = R(first[lo]);
+            if (lo + 1 == n || pos == double(lo))
+            {
+                return low;
+            }
+            R high = R(*std::min_element(first + std::ptrdiff_t(lo) + 1, last));
+            return low + (high - low) * R(pos - double(lo));
+        }
+
+        // Selects the k largest of the n values value(j) with a heap of
+        // size k whose top is the smallest selected value, so that most of
+        // the values are rejected by a single comparison when k is much
+        // smaller than n. The selection is written from the largest value
+        // to the smallest one, ties being ordered by index.
+        template <class T, class V>
+        inline void select_top(const V& value, std::size_t n, std::size_t k,
+                               std::vector<std::pair<T, std::size_t>>& heap,
+                               T* values, std::size_t* indices, std::size_t stride)
+        {
+            using pair_type = std::pair<T, std::size_t>;
+            auto better = [](const pair_type& lhs, const pair_type& rhs) {
+                return rhs.first < lhs.first || (!(lhs.first < rhs.first) && lhs.second < rhs.second);
+            };
+            heap.clear();
+            for (std::size_t j = 0; j < k; ++j)
+            {
+                heap.emplace_back(value(j), j);
+            }
+            std::make_heap(heap.begin(), heap.end(), better);
+            for (std::size_t j = k; j < n; ++j)
+            {
+                T v = value(j);
+                if (heap.front().first < v)
+                {
+                    std::pop_heap(heap.begin(), heap.end(), better);
+                    heap.back() = pair_type(v, j);
+                    std::push_heap(heap.begin(), heap.end(), better);
+                }
+            }
+            std::sort_heap(heap.begin(), heap.end(), better);
+            for (std::size_t j = 0; j < k; ++j)
+            {
+                values[j * stride] = heap[j].first;
+                indices[j * stride] = heap[j].second;
+            }
+        }
+
+        inline void check_percentile(double q)
+        {
+            if (!(q >= 0. && q <= 100.))
+            {
+                throw std::out_of_range("Percentile must be in [0, 100]");
+            }
+        }
+    }
+
+    /**
+     * @defgroup sort_functions Sorting functions
+     */
+
+    /**
+     * @ingroup sort_functions
+     * @brief Sorts the container \em e along the given axis, in place.
+     *
+     * The lines along the axis are sorted in ascending order, in parallel.
+     * They are sorted directly in the storage of \em e when they are
+     * contiguous, and gathered one after the other otherwise.
+     * @param e the container to sort
+     * @param axis the axis along which the elements are sorted
+     */
+    template <class E>
+    inline void sort_in_place(xexpression<E>& e, std::size_t axis)
+    {
+        using value_type = typename E::value_type;
+        detail::apply_along_axis(e.derived_cast(), axis, [](value_type* first, value_type* last, std::size_t) {
+            std::sort(first, last);
+        });
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the elements of \em e sorted along the given axis.
+     *
+     * The result is an xtensor if the shape of \em e has a fixed number of
+     * dimensions, an xarray otherwise.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the elements are sorted
+     * @sa sort_in_place
+     */
+    template <class E>
+    inline auto sort(const xexpression<E>& e, std::size_t axis)
+    {
+        detail::sort_result_t<E, typename E::value_type> res = e.derived_cast();
+        sort_in_place(res, axis);
+        return res;
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the indices that sort \em e along the given axis.
+     *
+     * Equal elements keep their relative order.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the elements are sorted
+     */
+    template <class E>
+    inline auto argsort(const xexpression<E>& e, std::size_t axis)
+    {
+        const E& de = e.derived_cast();
+        if (axis >= de.dimension())
+        {
+            throw std::out_of_range("Sorting axis out of bounds");
+        }
+        return detail::arg_along_axis(de, axis, [](auto first, auto last, auto comp) {
+            std::sort(first, last, comp);
+        });
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Partially sorts \em e along the given axis.
+     *
+     * In each line along the axis, the element at position \em kth is the
+     * one that would be there if the line was sorted, the elements before
+     * it are not greater and the elements after it are not less.
+     * @param e an \ref xexpression
+     * @param kth the position of the partitioning element
+     * @param axis the axis along which the elements are partitioned
+     */
+    template <class E>
+    inline auto partition(const xexpression<E>& e, std::size_t kth, std::size_t axis)
+    {
+        using value_type = typename E::value_type;
+        detail::sort_result_t<E, value_type> res = e.derived_cast();
+        detail::check_kth(res, kth, axis);
+        detail::apply_along_axis(res, axis, [kth](value_type* first, value_type* last, std::size_t) {
+            std::nth_element(first, first + std::ptrdiff_t(kth), last);
+        });
+        return res;
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the indices that partition \em e along the given axis.
+     * @param e an \ref xexpression
+     * @param kth the position of the partitioning element
+     * @param axis the axis along which the elements are partitioned
+     * @sa partition
+     */
+    template <class E>
+    inline auto argpartition(const xexpression<E>& e, std::size_t kth, std::size_t axis)
+    {
+        const E& de = e.derived_cast();
+        detail::check_kth(de, kth, axis);
+        return detail::arg_along_axis(de, axis, [kth](auto first, auto last, auto comp) {
+            std::nth_element(first, first + std::ptrdiff_t(kth), last, comp);
+        });
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the q-th percentile of \em e along the given axis.
+     *
+     * The percentile is linearly interpolated between the two closest
+     * ranks, and is NaN for empty lines. Integral values give double
+     * results.
+     * @param e an \ref xexpression
+     * @param q the percentile, in [0, 100]
+     * @param axis the axis along which the percentile is computed
+     * @return an xarray with the shape of \em e without \em axis
+     */
+    template <class E>
+    inline auto percentile(const xexpression<E>& e, double q, std::size_t axis)
+    {
+        using value_type = typename E::value_type;
+        using result_type = detail::percentile_value_type_t<value_type>;
+        using result_container = xarray<result_type>;
+        const E& de = e.derived_cast();
+        auto shape = detail::shape_without_axis<result_container>(de, axis);
+        detail::check_percentile(q);
+        result_container res = result_container::from_shape(shape);
+        if (res.size() == 0)
+        {
+            return res;
+        }
+        if (de.shape()[axis] == 0)
+        {
+            std::fill(res.data().begin(), res.data().end(), std::numeric_limits<result_type>::quiet_NaN());
+            return res;
+        }
+
+        xarray<value_type> values = de;
+        result_type* out = &res.data_element(0);
+        detail::for_each_line(&values.data_element(0), detail::make_line_geometry(values.shape(), axis, values.layout()),
+                              [out, q](value_type* first, value_type* last, std::size_t l) {
+                                  out[l] = detail::percentile_line<result_type>(first, last, q);
+                              });
+        return res;
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the q-th percentile of all the elements of \em e.
+     * @param e an \ref xexpression
+     * @param q the percentile, in [0, 100]
+     */
+    template <class E>
+    inline auto percentile(const xexpression<E>& e, double q)
+    {
+        using value_type = typename E::value_type;
+        using result_type = detail::percentile_value_type_t<value_type>;
+        const E& de = e.derived_cast();
+        detail::check_percentile(q);
+        uvector<value_type> values(de.size());
+        std::copy(de.cbegin(), de.cend(), values.begin());
+        return detail::percentile_line<result_type>(values.data(), values.data() + values.size(), q);
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the median of \em e along the given axis.
+     * @param e an \ref xexpression
+     * @param axis the axis along which the median is computed
+     * @sa percentile
+     */
+    template <class E>
+    inline auto median(const xexpression<E>& e, std::size_t axis)
+    {
+        return percentile(e, 50., axis);
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the median of all the elements of \em e.
+     * @param e an \ref xexpression
+     */
+    template <class E>
+    inline auto median(const xexpression<E>& e)
+    {
+        return percentile(e, 50.);
+    }
+
+    /**
+     * @ingroup sort_functions
+     * @brief Returns the \em k largest values of \em e along the given
+     * axis and their indices.
+     *
+     * The values of each line are selected with a heap holding the \em k
+     * largest values found so far, so that the cost is proportional to
+     * the length of the line when \em k is small. The selected values are
+     * sorted from the largest to the smallest, equal values being ordered
+     * by index. The lines are processed in parallel.
+     * @param e an \ref xexpression
+     * @param k the number of values to select
+     * @param axis the axis along which the values are selected
+     * @return a pair holding the values and their indices along \em axis,
+     * whose shape is the shape of \em e with \em k elements along \em axis
+     */
+    template <class E>
+    inline auto topk(const xexpression<E>& e, std::size_t k, std::size_t axis)
+    {
+        using value_type = typename E::value_type;
+        // The results are filled at row-major offsets.
+        using values_type = detail::sort_result_t<E, value_type, layout_type::row_major>;
+        using indices_type = detail::sort_result_t<E, std::size_t, layout_type::row_major>;
+        const E& de = e.derived_cast();
+        if (axis >= de.dimension())
+        {
+            throw std::out_of_range("Sorting axis out of bounds");
+        }
+        if (k > de.shape()[axis])
+        {
+            throw std::out_of_range("topk: k is larger than the axis");
+        }
+
+        typename values_type::shape_type shape;
+        resize_container(shape, de.dimension());
+        std::copy(de.shape().cbegin(), de.shape().cend(), shape.begin());
+        shape[axis] = k;
+        auto res = std::make_pair(values_type::from_shape(shape), indices_type::from_shape(shape));
+        if (res.first.size() == 0)
+        {
+            return res;
+        }
+
+        auto select = [&res, k, axis](const auto& d) {
+            detail::line_geometry g = detail::make_line_geometry(d.shape(), axis, layout_type::row_major);
+            value_type* values = &res.first.data_element(0);
+            std::size_t* indices = &res.second.data_element(0);
+            std::size_t grain = std::max(XTENSOR_PARALLEL_GRAIN_SIZE / g.n, std::size_t(1));
+            parallel_for(g.size(), grain, [&d, &g, values, indices, k](std::size_t first, std::size_t last) {
+                std::vector<std::pair<value_type, std::size_t>> heap;
+                heap.reserve(k);
+                for (std::size_t l = first; l < last; ++l)
+                {
+                    std::size_t offset = g.line_offset(l);
+                    std::size_t out = (l / g.inner) * k * g.inner + l % g.inner;
+                    auto value = [&d, &g, offset](std::size_t j) { return d.data_element(offset + j * g.inner); };
+                    detail::select_top<value_type>(value, g.n, k, heap, values + out, indices + out, g.inner);
+                }
+            });
+        };
+        auto evaluated = [&select](const auto& d) {
+            xarray<value_type, layout_type::row_major> v = d;
+            select(v);
+        };
+        dispatch_linear(de, [&select, &evaluated](const auto& d, layout_type l) {
+            if (l == layout_type::row_major)
+            {
+                select(d);
+            }
+            else
+            {
+                evaluated(d);
+            }
+        }, evaluated);
+        return res;
+    }
+}
+
+#endif
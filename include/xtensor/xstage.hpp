@@ -0,0 +1,509 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XSTAGE_HPP
+#define XSTAGE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xbatch.hpp"
+#include "xbroadcast.hpp"
+#include "xexpression.hpp"
+#include "xfunction.hpp"
+#include "xiterable.hpp"
+#include "xstrides.hpp"
+#include "xutils.hpp"
+
+namespace xt
+{
+
+    /*********
+     * stage *
+     *********/
+
+    template <class E>
+    auto stage(E&& e) noexcept;
+
+    /**********
+     * xstage *
+     **********/
+
+    template <class CT>
+    class xstage;
+
+    template <class CT>
+    struct xiterable_inner_types<xstage<CT>>
+    {
+        using xexpression_type = std::decay_t<CT>;
+        using inner_shape_type = typename xexpression_type::shape_type;
+        using const_stepper = typename xexpression_type::const_stepper;
+        using stepper = const_stepper;
+    };
+
+    /**
+     * @class xstage
+     * @brief Subexpression evaluated by chunks into a scratch buffer.
+     *
+     * The xstage class marks a subexpression whose values are stored
+     * in a scratch buffer when the enclosing expression is assigned. The
+     * assignment then processes the result by chunks of XTENSOR_CHUNK_SIZE
+     * bytes: each staged subexpression is evaluated on the chunk, then the
+     * enclosing expression reads the chunk from the scratch buffer. Unlike
+     * \ref eval, no full-size temporary is allocated, and the intermediate
+     * results stay in the cache.
+     *
+     * Chunks are used when the assignment is trivial, i.e. when the
+     * assigned container and all the operands share the same contiguous
+     * layout. Otherwise, and when it is accessed outside of an assignment,
+     * an xstage computes its values from the subexpression, like the
+     * subexpression itself. xstage is not meant to be used directly, but
+     * only with the \ref stage helper function.
+     *
+     * @tparam CT the closure type of the staged \ref xexpression
+     *
+     * @sa stage
+     */
+    template <class CT>
+    class xstage : public xexpression<xstage<CT>>,
+                   public xconst_iterable<xstage<CT>>
+    {
+    public:
+
+        using self_type = xstage<CT>;
+        using xexpression_type = std::decay_t<CT>;
+
+        using value_type = typename xexpression_type::value_type;
+        using reference = value_type;
+        using const_reference = value_type;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using size_type = typename xexpression_type::size_type;
+        using difference_type = typename xexpression_type::difference_type;
+
+        using iterable_base = xconst_iterable<self_type>;
+        using inner_shape_type = typename iterable_base::inner_shape_type;
+        using shape_type = inner_shape_type;
+
+        using stepper = typename iterable_base::stepper;
+        using const_stepper = typename iterable_base::const_stepper;
+
+        static constexpr layout_type static_layout = xexpression_type::static_layout;
+        static constexpr bool contiguous_layout = xexpression_type::contiguous_layout;
+        static constexpr bool simd_interface = has_simd_interface<xexpression_type>::value;
+
+        explicit xstage(CT e);
+
+        size_type size() const noexcept;
+        size_type dimension() const noexcept;
+        const inner_shape_type& shape() const noexcept;
+        layout_type layout() const noexcept;
+
+        template <class... Args>
+        const_reference operator()(Args... args) const;
+        const_reference operator[](const xindex& index) const;
+        const_reference operator[](size_type i) const;
+
+        template <class It>
+        const_reference element(It first, It last) const;
+
+        template <class S>
+        bool broadcast_shape(S& shape) const;
+
+        template <class S>
+        bool is_trivial_broadcast(const S& strides) const noexcept;
+
+        template <class F>
+        bool visit_strides(F&& f) const;
+
+        template <class F>
+        bool visit_memory(F&& f) const;
+
+        template <class F>
+        void visit_stages(F&& f) const;
+
+        template <class S>
+        const_stepper stepper_begin(const S& shape) const noexcept;
+        template <class S>
+        const_stepper stepper_end(const S& shape, layout_type l) const noexcept;
+
+        const_reference data_element(size_type i) const;
+
+        template <class B, class Mode = unaligned_mode>
+        B load_batch(size_type i) const;
+
+        void reserve_chunks(size_type chunk_size, size_type nb_chunks) const;
+        void prepare_chunk(size_type first, size_type last) const;
+        void release_chunks() const noexcept;
+
+    private:
+
+        CT m_e;
+
+        // The scratch buffer is a ring of nb_chunks chunks: the chunk
+        // starting at index i is stored at i & m_mask, so that threads
+        // assigning different chunks modulo nb_chunks never share memory.
+        mutable std::vector<value_type> m_buffer;
+        mutable std::vector<size_type> m_chunks;
+        mutable size_type m_chunk_size;
+        mutable size_type m_mask;
+    };
+
+    /************************
+     * stage implementation *
+     ************************/
+
+    /**
+     * @brief Returns an \ref xexpression evaluated by chunks into a scratch
+     * buffer when the enclosing expression is assigned.
+     *
+     * Staging a subexpression used several times, or costly to compute,
+     * avoids both its recomputation and the full-size temporary that
+     * \ref eval would allocate:
+     *
+     * \code{.cpp}
+     * xt::xarray<double> x = xt::random::rand<double>({1000, 1000});
+     * xt::xarray<double> y = xt::random::rand<double>({1000, 1000});
+     * auto d = xt::stage(x - y);
+     * xt::xarray<double> res = d / xt::sqrt(d * d + 1.);
+     * \endcode
+     *
+     * @param e the \ref xexpression to stage
+     *
+     * The returned expression either hold a const reference to \p e or a copy
+     * depending on whether \p e is an lvalue or an rvalue.
+     */
+    template <class E>
+    inline auto stage(E&& e) noexcept
+    {
+        return xstage<const_xclosure_t<E>>(std::forward<E>(e));
+    }
+
+    /*************************
+     * xstage implementation *
+     *************************/
+
+    /**
+     * @name Constructor
+     */
+    //@{
+    /**
+     * Constructs an xstage expression staging the specified \ref xexpression.
+     *
+     * @param e the expression to stage
+     */
+    template <class CT>
+    inline xstage<CT>::xstage(CT e)
+        : m_e(e), m_buffer(), m_chunks(), m_chunk_size(0), m_mask(0)
+    {
+    }
+    //@}
+
+    /**
+     * @name Size and shape
+     */
+    /**
+     * Returns the size of the expression.
+     */
+    template <class CT>
+    inline auto xstage<CT>::size() const noexcept -> size_type
+    {
+        return compute_size(shape());
+    }
+
+    /**
+     * Returns the number of dimensions of the expression.
+     */
+    template <class CT>
+    inline auto xstage<CT>::dimension() const noexcept -> size_type
+    {
+        return m_e.dimension();
+    }
+
+    /**
+     * Returns the shape of the expression.
+     */
+    template <class CT>
+    inline auto xstage<CT>::shape() const noexcept -> const inner_shape_type&
+    {
+        return m_e.shape();
+    }
+
+    /**
+     * Returns the layout_type of the expression.
+     */
+    template <class CT>
+    inline layout_type xstage<CT>::layout() const noexcept
+    {
+        return m_e.layout();
+    }
+    //@}
+
+    /**
+     * @name Data
+     */
+    /**
+     * Returns the element at the specified position in the expression.
+     * @param args a list of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices should be equal or greater than
+     * the number of dimensions of the expression.
+     */
+    template <class CT>
+    template <class... Args>
+    inline auto xstage<CT>::operator()(Args... args) const -> const_reference
+    {
+        return m_e(args...);
+    }
+
+    /**
+     * Returns the element at the specified position in the expression.
+     * @param index a sequence of indices specifying the position in the expression. Indices
+     * must be unsigned integers, the number of indices in the sequence should be equal or greater
+     * than the number of dimensions of the expression.
+     */
+    template <class CT>
+    inline auto xstage<CT>::operator[](const xindex& index) const -> const_reference
+    {
+        return m_e[index];
+    }
+
+    template <class CT>
+    inline auto xstage<CT>::operator[](size_type i) const -> const_reference
+    {
+        return operator()(i);
+    }
+
+    /**
+     * Returns the element at the specified position in the expression.
+     * @param first iterator starting the sequence of indices
+     * @param last iterator ending the sequence of indices
+     * The number of indices in the sequence should be equal to or greater
+     * than the number of dimensions of the expression.
+     */
+    template <class CT>
+    template <class It>
+    inline auto xstage<CT>::element(It first, It last) const -> const_reference
+    {
+        return m_e.element(first, last);
+    }
+    //@}
+
+    /**
+     * @name Broadcasting
+     */
+    //@{
+    /**
+     * Broadcast the shape of the expression to the specified parameter.
+     * @param shape the result shape
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class CT>
+    template <class S>
+    inline bool xstage<CT>::broadcast_shape(S& shape) const
+    {
+        return m_e.broadcast_shape(shape);
+    }
+
+    /**
+     * Compares the specified strides with those of the staged expression
+     * to see whether the broadcasting is trivial.
+     * @return a boolean indicating whether the broadcasting is trivial
+     */
+    template <class CT>
+    template <class S>
+    inline bool xstage<CT>::is_trivial_broadcast(const S& strides) const noexcept
+    {
+        return m_e.is_trivial_broadcast(strides);
+    }
+
+    /**
+     * Calls \c f with the strides of the staged expression.
+     * @return false if the strides of the expression are unknown
+     * @sa visit_strides
+     */
+    template <class CT>
+    template <class F>
+    inline bool xstage<CT>::visit_strides(F&& f) const
+    {
+        return xt::visit_strides(m_e, f);
+    }
+
+    /**
+     * Calls \c f with the range of memory of the staged expression.
+     * @return false if the memory of the expression is unknown
+     * @sa visit_memory
+     */
+    template <class CT>
+    template <class F>
+    inline bool xstage<CT>::visit_memory(F&& f) const
+    {
+        return xt::visit_memory(m_e, f);
+    }
+
+    /**
+     * Calls \c f with the stages of the staged expression, then with
+     * the expression itself.
+     * @sa visit_stages
+     */
+    template <class CT>
+    template <class F>
+    inline void xstage<CT>::visit_stages(F&& f) const
+    {
+        xt::visit_stages(m_e, f);
+        f(*this);
+    }
+    //@}
+
+    template <class CT>
+    template <class S>
+    inline auto xstage<CT>::stepper_begin(const S& shape) const noexcept -> const_stepper
+    {
+        return m_e.stepper_begin(shape);
+    }
+
+    template <class CT>
+    template <class S>
+    inline auto xstage<CT>::stepper_end(const S& shape, layout_type l) const noexcept -> const_stepper
+    {
+        return m_e.stepper_end(shape, l);
+    }
+
+    // data_element and load_batch read the scratch buffer between the
+    // calls to reserve_chunks and release_chunks; the chunk holding the
+    // index must have been prepared.
+    template <class CT>
+    inline auto xstage<CT>::data_element(size_type i) const -> const_reference
+    {
+        return m_buffer.empty() ? m_e.data_element(i) : m_buffer[i & m_mask];
+    }
+
+    template <class CT>
+    template <class B, class Mode>
+    inline B xstage<CT>::load_batch(size_type i) const
+    {
+        return m_buffer.empty() ? m_e.template load_batch<B, Mode>(i) : B::load_unaligned(m_buffer.data() + (i & m_mask));
+    }
+
+    namespace detail
+    {
+        template <bool simd>
+        struct stage_loop
+        {
+            template <class E, class T, class S>
+            static void run(const E& e, T* buffer, S first, S last)
+            {
+                for (S i = first; i < last; ++i)
+                {
+                    buffer[i - first] = e.data_element(i);
+                }
+            }
+        };
+
+        template <>
+        struct stage_loop<true>
+        {
+            template <class E, class T, class S>
+            static void run(const E& e, T* buffer, S first, S last)
+            {
+                using batch_type = xsimd_batch_t<T>;
+                constexpr S batch_size = xsimd_traits<T>::size;
+                S simd_last = first + (last - first) / batch_size * batch_size;
+                S i = first;
+                for (; i < simd_last; i += batch_size)
+                {
+                    e.template load_batch<batch_type>(i).store_unaligned(buffer + (i - first));
+                }
+                for (; i < last; ++i)
+                {
+                    buffer[i - first] = e.data_element(i);
+                }
+            }
+        };
+    }
+
+    /**
+     * @name Chunks
+     */
+    //@{
+    /**
+     * Allocates the scratch buffer for \c nb_chunks chunks of \c chunk_size
+     * elements; both must be powers of two. Chunks starting at indices that
+     * differ by a multiple of <tt>chunk_size * nb_chunks</tt> share the same
+     * memory.
+     */
+    template <class CT>
+    inline void xstage<CT>::reserve_chunks(size_type chunk_size, size_type nb_chunks) const
+    {
+        m_buffer.resize(chunk_size * nb_chunks);
+        m_chunks.assign(nb_chunks, std::numeric_limits<size_type>::max());
+        m_chunk_size = chunk_size;
+        m_mask = chunk_size * nb_chunks - 1;
+    }
+
+    /**
+     * Evaluates the staged expression on the chunk [first, last) into the
+     * scratch buffer. \c first must be a multiple of the chunk size and
+     * the nested stages must have been prepared on the same chunk.
+     */
+    template <class CT>
+    inline void xstage<CT>::prepare_chunk(size_type first, size_type last) const
+    {
+        // The stage may be visited several times if it is referenced by
+        // several nodes of the expression.
+        size_type& chunk = m_chunks[(first & m_mask) / m_chunk_size];
+        if (chunk != first)
+        {
+            using loop_type = detail::stage_loop<simd_interface && has_simd<value_type>::value>;
+            loop_type::run(m_e, m_buffer.data() + (first & m_mask), first, last);
+            chunk = first;
+        }
+    }
+
+    /**
+     * Frees the scratch buffer; the values are then computed from the
+     * staged expression again.
+     */
+    template <class CT>
+    inline void xstage<CT>::release_chunks() const noexcept
+    {
+        std::vector<value_type>().swap(m_buffer);
+        std::vector<size_type>().swap(m_chunks);
+        m_chunk_size = 0;
+        m_mask = 0;
+    }
+    //@}
+
+    /**
+     * Checks whether the expression \c E holds an xstage that
+     * visit_stages can reach.
+     */
+    template <class E>
+    struct has_stage : std::false_type
+    {
+    };
+
+    template <class CT>
+    struct has_stage<xstage<CT>> : std::true_type
+    {
+    };
+
+    template <class F, class R, class... CT>
+    struct has_stage<xfunction<F, R, CT...>> : or_<has_stage<std::decay_t<CT>>...>
+    {
+    };
+
+    template <class CT, class X>
+    struct has_stage<xbroadcast<CT, X>> : has_stage<std::decay_t<CT>>
+    {
+    };
+}
+
+#endif
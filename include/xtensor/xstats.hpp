@@ -0,0 +1,238 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XSTATS_HPP
+#define XSTATS_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "xarray.hpp"
+#include "xreducer.hpp"
+
+namespace xt
+{
+
+    /**********
+     * xstats *
+     **********/
+
+    /**
+     * @class xstats
+     * @brief Statistics of an expression over given axes.
+     *
+     * The xstats class holds the number of elements, the mean, the sum
+     * of squared differences from the mean (M2), the minimum and the
+     * maximum of an expression over the reduced axes, as returned by
+     * \ref stats. All the members have the shape of the reduction.
+     *
+     * @tparam T the value type of the mean and of M2
+     * @tparam V the value type of the minimum and of the maximum
+     */
+    template <class T, class V>
+    struct xstats
+    {
+        using value_type = T;
+        using extremum_type = V;
+
+        xarray<std::size_t> count;
+        xarray<T> mean;
+        xarray<T> m2;
+        xarray<V> min;
+        xarray<V> max;
+
+        xarray<T> variance(std::size_t ddof = 0) const;
+    };
+
+    template <class E, class X>
+    auto stats(E&& e, X&& axes);
+
+    template <class E>
+    auto stats(E&& e);
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    auto stats(E&& e, std::initializer_list<I> axes);
+#else
+    template <class E, class I, std::size_t N>
+    auto stats(E&& e, const I (&axes)[N]);
+#endif
+
+    /*************************
+     * xstats implementation *
+     *************************/
+
+    /**
+     * Returns the variance, i.e. M2 divided by <tt>count - ddof</tt>.
+     * The variance is NaN where \c count is not greater than \c ddof.
+     * @param ddof the delta degrees of freedom
+     */
+    template <class T, class V>
+    inline xarray<T> xstats<T, V>::variance(std::size_t ddof) const
+    {
+        xarray<T> res = xarray<T>::from_shape(m2.shape());
+        for (std::size_t i = 0; i < res.size(); ++i)
+        {
+            std::size_t n = count.data()[i];
+            res.data()[i] = n > ddof ? m2.data()[i] / T(n - ddof) : std::numeric_limits<T>::quiet_NaN();
+        }
+        return res;
+    }
+
+    namespace detail
+    {
+        template <class V>
+        using stats_value_type_t = std::conditional_t<std::is_integral<V>::value, double, V>;
+
+        template <class T, class V>
+        struct stats_accumulator
+        {
+            std::size_t count;
+            T mean;
+            T m2;
+            V min;
+            V max;
+        };
+
+        // Welford's update for a single element and Chan's formula for
+        // merging two partial results, so that the reduction can be split
+        // between tasks without losing the numerical stability.
+        template <class V>
+        struct stats_functor
+        {
+            using value_type = stats_value_type_t<V>;
+            using result_type = stats_accumulator<value_type, V>;
+
+            result_type operator()(const result_type& acc, const V& v) const
+            {
+                if (acc.count == 0)
+                {
+                    return result_type{1, value_type(v), value_type(0), v, v};
+                }
+                result_type res = acc;
+                ++res.count;
+                value_type delta = value_type(v) - res.mean;
+                res.mean += delta / value_type(res.count);
+                res.m2 += delta * (value_type(v) - res.mean);
+                res.min = v < res.min ? v : res.min;
+                res.max = res.max < v ? v : res.max;
+                return res;
+            }
+
+            result_type operator()(const result_type& lhs, const result_type& rhs) const
+            {
+                if (lhs.count == 0)
+                {
+                    return rhs;
+                }
+                if (rhs.count == 0)
+                {
+                    return lhs;
+                }
+                result_type res;
+                res.count = lhs.count + rhs.count;
+                value_type n = value_type(res.count);
+                value_type nl = value_type(lhs.count);
+                value_type nr = value_type(rhs.count);
+                value_type delta = rhs.mean - lhs.mean;
+                res.mean = lhs.mean + delta * (nr / n);
+                res.m2 = lhs.m2 + rhs.m2 + delta * delta * (nl * nr / n);
+                res.min = rhs.min < lhs.min ? rhs.min : lhs.min;
+                res.max = lhs.max < rhs.max ? rhs.max : lhs.max;
+                return res;
+            }
+        };
+
+        template <class V>
+        inline auto make_stats_functor()
+        {
+            using result_type = typename stats_functor<V>::result_type;
+            return make_xreducer_functor(stats_functor<V>(), const_value<result_type>(result_type{0, 0, 0, V(), V()}));
+        }
+
+        template <class R>
+        inline auto split_stats(const R& r)
+        {
+            using accumulator_type = typename R::value_type;
+            using value_type = decltype(std::declval<accumulator_type>().mean);
+            using extremum_type = decltype(std::declval<accumulator_type>().min);
+            using result_type = xstats<value_type, extremum_type>;
+
+            result_type res;
+            res.count = xarray<std::size_t>::from_shape(r.shape());
+            res.mean = xarray<value_type>::from_shape(r.shape());
+            res.m2 = xarray<value_type>::from_shape(r.shape());
+            res.min = xarray<extremum_type>::from_shape(r.shape());
+            res.max = xarray<extremum_type>::from_shape(r.shape());
+            for (std::size_t i = 0; i < r.size(); ++i)
+            {
+                const accumulator_type& acc = r.data()[i];
+                res.count.data()[i] = acc.count;
+                res.mean.data()[i] = acc.mean;
+                res.m2.data()[i] = acc.m2;
+                res.min.data()[i] = acc.min;
+                res.max.data()[i] = acc.max;
+            }
+            return res;
+        }
+
+        template <class E, class X>
+        inline auto stats_impl(E&& e, X&& axes)
+        {
+            using value_type = typename std::decay_t<E>::value_type;
+            using accumulator_type = typename stats_functor<value_type>::result_type;
+            xarray<accumulator_type> r = reduce(make_stats_functor<value_type>(), std::forward<E>(e), std::forward<X>(axes));
+            return split_stats(r);
+        }
+    }
+
+    /**
+     * @ingroup red_functions
+     * @brief Count, mean, M2, minimum and maximum over given axes.
+     *
+     * Computes the statistics of \em e over the given \em axes in a single
+     * pass, with Welford's algorithm. The mean and M2 of integral expressions
+     * are computed in double precision. The minimum and maximum of an empty
+     * reduction are value-initialized.
+     * @param e an \ref xexpression
+     * @param axes the axes along which the statistics are computed (optional)
+     * @return an \ref xstats
+     */
+    template <class E, class X>
+    inline auto stats(E&& e, X&& axes)
+    {
+        return detail::stats_impl(std::forward<E>(e), std::forward<X>(axes));
+    }
+
+    template <class E>
+    inline auto stats(E&& e)
+    {
+        using value_type = typename std::decay_t<E>::value_type;
+        using accumulator_type = typename detail::stats_functor<value_type>::result_type;
+        xarray<accumulator_type> r = reduce(detail::make_stats_functor<value_type>(), std::forward<E>(e));
+        return detail::split_stats(r);
+    }
+
+#ifdef X_OLD_CLANG
+    template <class E, class I>
+    inline auto stats(E&& e, std::initializer_list<I> axes)
+    {
+        return detail::stats_impl(std::forward<E>(e), axes);
+    }
+#else
+    template <class E, class I, std::size_t N>
+    inline auto stats(E&& e, const I (&axes)[N])
+    {
+        return detail::stats_impl(std::forward<E>(e), axes);
+    }
+#endif
+}
+
+#endif
@@ -10,11 +10,18 @@
 #define XSTORAGE_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <new>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "xutils.hpp"
 
@@ -28,6 +35,176 @@ namespace xt
                                                                                std::input_iterator_tag>::value>::type;
     }
 
+    /*********************
+     * aligned_allocator *
+     *********************/
+
+    /**
+     * @class aligned_allocator
+     * @brief Allocator returning memory aligned on \c Align bytes.
+     *
+     * The aligned_allocator class satisfies the requirements of the standard
+     * allocators. Since the alignment of the memory is part of its type,
+     * containers using it can rely on it at compile time (see container_alignment).
+     *
+     * @tparam T the type of the allocated values
+     * @tparam Align the alignment in bytes, a power of two
+     */
+    template <class T, std::size_t Align>
+    class aligned_allocator
+    {
+    public:
+
+        static_assert(Align != 0 && (Align & (Align - 1)) == 0, "alignment must be a power of two");
+
+        using value_type = T;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr std::size_t alignment = Align;
+
+        template <class U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Align>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template <class U>
+        aligned_allocator(const aligned_allocator<U, Align>& rhs) noexcept;
+
+        pointer allocate(size_type n, const void* hint = nullptr);
+        void deallocate(pointer p, size_type n) noexcept;
+
+        size_type max_size() const noexcept;
+
+        template <class U, class... Args>
+        void construct(U* p, Args&&... args);
+
+        template <class U>
+        void destroy(U* p);
+    };
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    bool operator==(const aligned_allocator<T1, A1>& lhs, const aligned_allocator<T2, A2>& rhs) noexcept;
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    bool operator!=(const aligned_allocator<T1, A1>& lhs, const aligned_allocator<T2, A2>& rhs) noexcept;
+
+    /************************************
+     * aligned_allocator implementation *
+     ************************************/
+
+    namespace detail
+    {
+        // The address returned by malloc is stored right before the
+        // aligned block, which requires alignment >= sizeof(void*).
+        inline void* aligned_malloc(std::size_t size, std::size_t alignment) noexcept
+        {
+            void* raw = std::malloc(size + alignment);
+            if (raw == nullptr)
+            {
+                return nullptr;
+            }
+            std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(raw) & ~(std::uintptr_t(alignment) - 1)) + alignment;
+            void* res = reinterpret_cast<void*>(address);
+            *(reinterpret_cast<void**>(res) - 1) = raw;
+            return res;
+        }
+
+        inline void aligned_free(void* ptr) noexcept
+        {
+            if (ptr != nullptr)
+            {
+                std::free(*(reinterpret_cast<void**>(ptr) - 1));
+            }
+        }
+
+        template <class T, std::size_t Align>
+        constexpr std::size_t allocation_alignment() noexcept
+        {
+            std::size_t res = Align < alignof(T) ? alignof(T) : Align;
+            return res < sizeof(void*) ? sizeof(void*) : res;
+        }
+    }
+
+    template <class T, std::size_t Align>
+    constexpr std::size_t aligned_allocator<T, Align>::alignment;
+
+    template <class T, std::size_t Align>
+    template <class U>
+    inline aligned_allocator<T, Align>::aligned_allocator(const aligned_allocator<U, Align>&) noexcept
+    {
+    }
+
+    /**
+     * Allocates uninitialized memory for \c n values, aligned on \c Align
+     * bytes (or on the alignment of \c T if it is stricter).
+     * @throw std::bad_alloc if the allocation fails.
+     */
+    template <class T, std::size_t Align>
+    inline auto aligned_allocator<T, Align>::allocate(size_type n, const void*) -> pointer
+    {
+        if (n > max_size())
+        {
+            throw std::bad_alloc();
+        }
+        void* res = detail::aligned_malloc(n * sizeof(T), detail::allocation_alignment<T, Align>());
+        if (res == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return reinterpret_cast<pointer>(res);
+    }
+
+    template <class T, std::size_t Align>
+    inline void aligned_allocator<T, Align>::deallocate(pointer p, size_type) noexcept
+    {
+        detail::aligned_free(p);
+    }
+
+    template <class T, std::size_t Align>
+    inline auto aligned_allocator<T, Align>::max_size() const noexcept -> size_type
+    {
+        return (std::numeric_limits<size_type>::max() - Align - sizeof(void*)) / sizeof(T);
+    }
+
+    template <class T, std::size_t Align>
+    template <class U, class... Args>
+    inline void aligned_allocator<T, Align>::construct(U* p, Args&&... args)
+    {
+        new (const_cast<void*>(static_cast<const void*>(p))) U(std::forward<Args>(args)...);
+    }
+
+    template <class T, std::size_t Align>
+    template <class U>
+    inline void aligned_allocator<T, Align>::destroy(U* p)
+    {
+        p->~U();
+    }
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    inline bool operator==(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2>&) noexcept
+    {
+        return A1 == A2;
+    }
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    inline bool operator!=(const aligned_allocator<T1, A1>& lhs, const aligned_allocator<T2, A2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /***********
+     * uvector *
+     ***********/
+
     template <class T, class Allocator = std::allocator<T>>
     class uvector
     {
@@ -531,6 +708,52 @@ namespace xt
     {
         lhs.swap(rhs);
     }
+
+    /***********************
+     * container_alignment *
+     ***********************/
+
+    /**
+     * @class allocator_alignment
+     * @brief Alignment in bytes guaranteed by an allocator at compile time.
+     *
+     * Only the alignment of the value type is guaranteed for an arbitrary
+     * allocator; aligned_allocator guarantees its \c Align parameter.
+     */
+    template <class A>
+    struct allocator_alignment : std::integral_constant<std::size_t, alignof(typename A::value_type)>
+    {
+    };
+
+    template <class T, std::size_t Align>
+    struct allocator_alignment<aligned_allocator<T, Align>>
+        : std::integral_constant<std::size_t, detail::allocation_alignment<T, Align>()>
+    {
+    };
+
+    /**
+     * @class container_alignment
+     * @brief Alignment in bytes of the first element of a container, known
+     * at compile time.
+     *
+     * Containers whose storage is allocated by an allocator report the
+     * alignment of this allocator; other containers only guarantee the
+     * alignment of their value type.
+     */
+    template <class C>
+    struct container_alignment : std::integral_constant<std::size_t, alignof(typename C::value_type)>
+    {
+    };
+
+    template <class T, class A>
+    struct container_alignment<uvector<T, A>> : allocator_alignment<A>
+    {
+    };
+
+    template <class T, class A>
+    struct container_alignment<std::vector<T, A>> : allocator_alignment<A>
+    {
+    };
 }
 
 #endif
@@ -135,6 +135,12 @@ namespace xt
         template <class O>
         bool is_trivial_broadcast(const O& strides) const noexcept;
 
+        template <class F>
+        bool visit_strides(F&& f) const;
+
+        template <class F>
+        bool visit_memory(F&& f) const;
+
         template <class ST>
         stepper stepper_begin(const ST& shape);
         template <class ST>
@@ -442,6 +448,31 @@ namespace xt
         return str.size() == strides().size() &&
             std::equal(str.cbegin(), str.cend(), strides().begin());
     }
+
+    /**
+     * Calls \c f with the strides of the view.
+     * @return true, the strides of a strided view are always known
+     * @sa visit_strides
+     */
+    template <class CT, class S, class CD>
+    template <class F>
+    inline bool xstrided_view<CT, S, CD>::visit_strides(F&& f) const
+    {
+        f(strides());
+        return true;
+    }
+
+    /**
+     * Calls \c f with the range of memory of the underlying expression.
+     * @return false if the memory of the underlying expression is unknown
+     * @sa visit_memory
+     */
+    template <class CT, class S, class CD>
+    template <class F>
+    inline bool xstrided_view<CT, S, CD>::visit_memory(F&& f) const
+    {
+        return xt::visit_memory(m_e, f);
+    }
     //@}
 
     /***************
@@ -15,6 +15,7 @@
 
 #include "xexception.hpp"
 #include "xtensor_forward.hpp"
+#include "xutils.hpp"
 
 namespace xt
 {
@@ -63,6 +64,45 @@ namespace xt
     template <class S1, class S2>
     bool broadcastable(const S1& s1, S2& s2);
 
+    /*****************
+     * stride visits *
+     *****************/
+
+    template <class E, class F>
+    bool visit_strides(const E& e, F&& f);
+
+    template <class S, class ST>
+    std::size_t broadcast_stride(const S& shape, const ST& strides, std::size_t dim) noexcept;
+
+    template <class E, class S>
+    bool is_mergeable(const E& e, const S& shape, std::size_t outer, std::size_t inner);
+
+    template <class E>
+    layout_type linear_layout(const E& e);
+
+    template <class E, class F, class G>
+    auto dispatch_linear(const E& e, F&& f, G&& g);
+
+    /*****************
+     * memory visits *
+     *****************/
+
+    template <class E, class F>
+    bool visit_memory(const E& e, F&& f);
+
+    template <class E>
+    struct has_memory_visitor;
+
+    template <class E1, class E2>
+    bool may_alias(const E1& e1, const E2& e2);
+
+    /****************
+     * stage visits *
+     ****************/
+
+    template <class E, class F>
+    void visit_stages(const E& e, F&& f);
+
     /********************************************
      * utility functions for strided containers *
      ********************************************/
@@ -262,6 +302,304 @@ namespace xt
         }
         return true;
     }
+
+    /********************************
+     * stride visits implementation *
+     ********************************/
+
+    namespace detail
+    {
+        template <class E, class F, class = void>
+        struct stride_visitor
+        {
+            static bool run(const E&, F&) noexcept
+            {
+                return false;
+            }
+        };
+
+        template <class E, class F>
+        struct stride_visitor<E, F, typename enable_if_type<decltype(std::declval<const E&>().visit_strides(std::declval<F&>()))>::type>
+        {
+            static bool run(const E& e, F& f)
+            {
+                return e.visit_strides(f);
+            }
+        };
+    }
+
+    /**
+     * Calls \c f with the strides of each leaf of the expression \c e that
+     * reads memory (containers, strided views). Leaves that don't read memory,
+     * such as scalars, are skipped.
+     * @return false if \c e or one of its subexpressions does not provide
+     * a visit_strides method, i.e. if its strides are unknown.
+     */
+    template <class E, class F>
+    inline bool visit_strides(const E& e, F&& f)
+    {
+        return detail::stride_visitor<E, std::decay_t<F>>::run(e, f);
+    }
+
+    /**
+     * Returns the stride along the dimension \c dim of \c shape of an
+     * expression with the specified strides, broadcast to \c shape.
+     */
+    template <class S, class ST>
+    inline std::size_t broadcast_stride(const S& shape, const ST& strides, std::size_t dim) noexcept
+    {
+        std::size_t offset = shape.size() - strides.size();
+        return dim < offset ? std::size_t(0) : static_cast<std::size_t>(strides[dim - offset]);
+    }
+
+    /**
+     * Checks whether the stepper of \c e, built for \c shape, can traverse the
+     * dimensions \c outer and \c inner as a single dimension by stepping along
+     * \c inner only. Expressions whose strides are unknown are never mergeable.
+     */
+    template <class E, class S>
+    inline bool is_mergeable(const E& e, const S& shape, std::size_t outer, std::size_t inner)
+    {
+        bool res = true;
+        auto check = [&res, &shape, outer, inner](const auto& strides) {
+            res = res && broadcast_stride(shape, strides, outer) ==
+                broadcast_stride(shape, strides, inner) * static_cast<std::size_t>(shape[inner]);
+        };
+        return visit_strides(e, check) && res;
+    }
+
+    namespace detail
+    {
+        template <class E>
+        inline layout_type linear_layout_impl(const E& e, std::true_type /*contiguous layout*/)
+        {
+            typename E::shape_type strides;
+            resize_container(strides, e.dimension());
+            compute_strides(e.shape(), layout_type::row_major, strides);
+            if (e.is_trivial_broadcast(strides))
+            {
+                return layout_type::row_major;
+            }
+            compute_strides(e.shape(), layout_type::column_major, strides);
+            if (e.is_trivial_broadcast(strides))
+            {
+                return layout_type::column_major;
+            }
+            return layout_type::dynamic;
+        }
+
+        template <class E>
+        inline layout_type linear_layout_impl(const E&, std::false_type /*contiguous layout*/)
+        {
+            return layout_type::dynamic;
+        }
+    }
+
+    /**
+     * Returns the layout in which <tt>e.data_element(i)</tt>, for \c i in
+     * <tt>[0, e.size())</tt>, traverses the elements of \c e, or
+     * layout_type::dynamic if the data elements of \c e cannot be accessed
+     * linearly.
+     */
+    template <class E>
+    inline layout_type linear_layout(const E& e)
+    {
+        return detail::linear_layout_impl(e, std::integral_constant<bool, E::contiguous_layout>());
+    }
+
+    namespace detail
+    {
+        template <class E, class F, class G>
+        inline auto dispatch_linear_impl(const E& e, F& f, G& g, std::true_type /*contiguous layout*/)
+        {
+            layout_type l = linear_layout(e);
+            if (l != layout_type::dynamic)
+            {
+                return f(e, l);
+            }
+            return g(e);
+        }
+
+        template <class E, class F, class G>
+        inline auto dispatch_linear_impl(const E& e, F&, G& g, std::false_type /*contiguous layout*/)
+        {
+            return g(e);
+        }
+    }
+
+    /**
+     * Calls <tt>f(e, l)</tt> if the data elements of \c e can be accessed
+     * linearly in the layout \c l, see linear_layout, and <tt>g(e)</tt>
+     * otherwise. \c f is not instantiated for expressions that don't
+     * provide data_element.
+     */
+    template <class E, class F, class G>
+    inline auto dispatch_linear(const E& e, F&& f, G&& g)
+    {
+        return detail::dispatch_linear_impl(e, f, g, std::integral_constant<bool, E::contiguous_layout>());
+    }
+
+    namespace detail
+    {
+        // Lines of a contiguous buffer along an axis: line l starts at
+        // line_offset(l) and holds n elements separated by inner elements.
+        struct line_geometry
+        {
+            std::size_t outer;
+            std::size_t n;
+            std::size_t inner;
+
+            std::size_t size() const noexcept
+            {
+                return outer * inner;
+            }
+
+            std::size_t line_offset(std::size_t l) const noexcept
+            {
+                return (l / inner) * n * inner + l % inner;
+            }
+        };
+
+        template <class S>
+        inline line_geometry make_line_geometry(const S& shape, std::size_t axis, layout_type l)
+        {
+            auto before = std::accumulate(shape.cbegin(), shape.cbegin() + std::ptrdiff_t(axis), std::size_t(1), std::multiplies<std::size_t>());
+            auto after = std::accumulate(shape.cbegin() + std::ptrdiff_t(axis) + 1, shape.cend(), std::size_t(1), std::multiplies<std::size_t>());
+            std::size_t n = shape[axis];
+            return l == layout_type::column_major ? line_geometry{after, n, before} : line_geometry{before, n, after};
+        }
+
+        // Shape of the result of a reduction of e along axis.
+        template <class C, class E>
+        inline typename C::shape_type shape_without_axis(const E& e, std::size_t axis)
+        {
+            if (axis >= e.dimension())
+            {
+                throw std::out_of_range("Axis out of bounds");
+            }
+            typename C::shape_type shape;
+            resize_container(shape, e.dimension() - 1);
+            std::copy(e.shape().cbegin(), e.shape().cbegin() + std::ptrdiff_t(axis), shape.begin());
+            std::copy(e.shape().cbegin() + std::ptrdiff_t(axis) + 1, e.shape().cend(), shape.begin() + std::ptrdiff_t(axis));
+            return shape;
+        }
+    }
+
+    /********************************
+     * memory visits implementation *
+     ********************************/
+
+    namespace detail
+    {
+        template <class E, class F, class = void>
+        struct memory_visitor
+        {
+            static bool run(const E&, F&) noexcept
+            {
+                return false;
+            }
+        };
+
+        template <class E, class F>
+        struct memory_visitor<E, F, typename enable_if_type<decltype(std::declval<const E&>().visit_memory(std::declval<F&>()))>::type>
+        {
+            static bool run(const E& e, F& f)
+            {
+                return e.visit_memory(f);
+            }
+        };
+
+        template <class E, class = void>
+        struct has_memory_visitor_impl : std::false_type
+        {
+        };
+
+        template <class E>
+        struct has_memory_visitor_impl<E, typename enable_if_type<decltype(std::declval<const E&>().visit_memory(std::declval<void (*&)(const void*, const void*)>()))>::type>
+            : std::true_type
+        {
+        };
+    }
+
+    /**
+     * Checks whether the expression \c E provides a visit_memory method.
+     */
+    template <class E>
+    struct has_memory_visitor
+        : detail::has_memory_visitor_impl<E>
+    {
+    };
+
+    /**
+     * Calls \c f(first, last) with the range of memory [first, last) of each
+     * leaf of the expression \c e that reads memory. Ranges are passed as
+     * <tt>const void*</tt>; leaves holding their value, such as scalars, are
+     * skipped.
+     * @return false if \c e or one of its subexpressions does not provide
+     * a visit_memory method, i.e. if the memory it reads is unknown.
+     */
+    template <class E, class F>
+    inline bool visit_memory(const E& e, F&& f)
+    {
+        return detail::memory_visitor<E, std::decay_t<F>>::run(e, f);
+    }
+
+    /**
+     * Checks whether the memory read by \c e2 may overlap the memory of \c e1.
+     * The result is conservative: expressions whose memory is unknown
+     * may always alias.
+     */
+    template <class E1, class E2>
+    inline bool may_alias(const E1& e1, const E2& e2)
+    {
+        bool res = false;
+        auto check_lhs = [&res, &e2](const void* first, const void* last) {
+            auto check_rhs = [&res, first, last](const void* rhs_first, const void* rhs_last) {
+                std::less<const void*> less;
+                res = res || (less(rhs_first, last) && less(first, rhs_last));
+            };
+            if (!visit_memory(e2, check_rhs))
+            {
+                res = true;
+            }
+        };
+        return !visit_memory(e1, check_lhs) || res;
+    }
+
+    /*******************************
+     * stage visits implementation *
+     *******************************/
+
+    namespace detail
+    {
+        template <class E, class F, class = void>
+        struct stage_visitor
+        {
+            static void run(const E&, F&) noexcept
+            {
+            }
+        };
+
+        template <class E, class F>
+        struct stage_visitor<E, F, typename enable_if_type<decltype(std::declval<const E&>().visit_stages(std::declval<F&>()))>::type>
+        {
+            static void run(const E& e, F& f)
+            {
+                e.visit_stages(f);
+            }
+        };
+    }
+
+    /**
+     * Calls \c f with each staged subexpression of \c e (see xstage),
+     * nested stages first. Expressions without a visit_stages method
+     * are considered as holding no stage.
+     */
+    template <class E, class F>
+    inline void visit_stages(const E& e, F&& f)
+    {
+        detail::stage_visitor<E, std::decay_t<F>>::run(e, f);
+    }
 }
 
 #endif
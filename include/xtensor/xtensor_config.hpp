@@ -22,6 +22,21 @@
     #endif
 #endif
 
+// Alignment in bytes of the elements of the containers allocated by
+// DEFAULT_ALLOCATOR when XTENSOR_USE_SIMD is defined: the size of a
+// cache line, which is also enough for the widest SIMD registers.
+#ifndef XTENSOR_ALIGNMENT
+#define XTENSOR_ALIGNMENT 64
+#endif
+
+#ifndef DEFAULT_ALLOCATOR
+#if defined(XTENSOR_USE_SIMD)
+#define DEFAULT_ALLOCATOR(T) xt::aligned_allocator<T, XTENSOR_ALIGNMENT>
+#else
+#define DEFAULT_ALLOCATOR(T) std::allocator<T>
+#endif
+#endif
+
 #ifndef DEFAULT_DATA_CONTAINER
 #define DEFAULT_DATA_CONTAINER(T, A) uvector<T, A>
 #endif
@@ -35,4 +50,30 @@
 #define DEFAULT_LAYOUT layout_type::row_major
 #endif
 
+// Minimal number of elements processed by a thread when
+// XTENSOR_USE_THREADS is defined.
+#ifndef XTENSOR_PARALLEL_GRAIN_SIZE
+#define XTENSOR_PARALLEL_GRAIN_SIZE 32768
+#endif
+
+// Size of the square tiles used to assign expressions whose
+// memory order differs from the one of the assigned container.
+#ifndef XTENSOR_TILE_SIZE
+#define XTENSOR_TILE_SIZE 32
+#endif
+
+// Size in bytes from which contiguous assignments bypass the cache
+// with non-temporal stores when XTENSOR_USE_SIMD is defined; 0 disables
+// non-temporal stores.
+#ifndef XTENSOR_STREAMING_THRESHOLD
+#define XTENSOR_STREAMING_THRESHOLD (32 * 1024 * 1024)
+#endif
+
+// Size in bytes of the scratch buffers holding the chunks of the staged
+// subexpressions of an assigned expression. The buffers of an assignment
+// and the chunks of its operands should fit in the L2 cache.
+#ifndef XTENSOR_CHUNK_SIZE
+#define XTENSOR_CHUNK_SIZE (64 * 1024)
+#endif
+
 #endif
@@ -48,7 +48,7 @@ namespace xt
      * @tparam SA The allocator of the containers holding the shape and the strides.
      */
     template <class T, layout_type L = DEFAULT_LAYOUT,
-              class A = std::allocator<T>,
+              class A = DEFAULT_ALLOCATOR(T),
               class SA = std::allocator<typename std::vector<T, A>::size_type>>
     using xarray = xarray_container<DEFAULT_DATA_CONTAINER(T, A), L, DEFAULT_SHAPE_CONTAINER(T, A, SA)>;
 
@@ -75,7 +75,7 @@ namespace xt
      * @tparam L The layout_type of the tensor (default: row_major).
      * @tparam A The allocator of the containers holding the elements.
      */
-    template <class T, std::size_t N, layout_type L = DEFAULT_LAYOUT, class A = std::allocator<T>>
+    template <class T, std::size_t N, layout_type L = DEFAULT_LAYOUT, class A = DEFAULT_ALLOCATOR(T)>
     using xtensor = xtensor_container<DEFAULT_DATA_CONTAINER(T, A), N, L>;
 
     template <class CT, class... S>
@@ -138,6 +138,9 @@ namespace xt
         template <class ST>
         bool is_trivial_broadcast(const ST& strides) const;
 
+        template <class F>
+        bool visit_memory(F&& f) const;
+
         template <class ST>
         stepper stepper_begin(const ST& shape);
         template <class ST>
@@ -632,6 +635,18 @@ namespace xt
     {
         return false;
     }
+
+    /**
+     * Calls \c f with the range of memory of the underlying expression.
+     * @return false if the memory of the underlying expression is unknown
+     * @sa visit_memory
+     */
+    template <class CT, class... S>
+    template <class F>
+    inline bool xview<CT, S...>::visit_memory(F&& f) const
+    {
+        return xt::visit_memory(m_e, f);
+    }
     //@}
 
     template <class CT, class... S>
@@ -0,0 +1,90 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "xtensor/xaccumulator.hpp"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xnoalias.hpp"
+#include "xtensor/xtensor.hpp"
+
+namespace xt
+{
+    TEST(xaccumulator, cumsum)
+    {
+        xarray<int> a = {{1, 2, 3}, {4, 5, 6}};
+        xarray<int> res0 = cumsum(a, 0);
+        xarray<int> res1 = cumsum(a, 1);
+        EXPECT_EQ(xarray<int>({{1, 2, 3}, {5, 7, 9}}), res0);
+        EXPECT_EQ(xarray<int>({{1, 3, 6}, {4, 9, 15}}), res1);
+
+        xarray<int, layout_type::column_major> b = a;
+        xarray<int, layout_type::column_major> res_cm = cumsum(b + 0, 1);
+        EXPECT_EQ(res1, res_cm);
+    }
+
+    TEST(xaccumulator, functions)
+    {
+        xarray<double> a = {{3., 1., 4.}, {1., 5., 9.}, {2., 6., 5.}};
+        xarray<double> prod0 = cumprod(a, 0);
+        xarray<double> min1 = cummin(a, 1);
+        xarray<double> max0 = cummax(a, 0);
+        EXPECT_EQ(xarray<double>({{3., 1., 4.}, {3., 5., 36.}, {6., 30., 180.}}), prod0);
+        EXPECT_EQ(xarray<double>({{3., 1., 1.}, {1., 1., 1.}, {2., 2., 2.}}), min1);
+        EXPECT_EQ(xarray<double>({{3., 1., 4.}, {3., 5., 9.}, {3., 6., 9.}}), max0);
+    }
+
+    TEST(xaccumulator, access)
+    {
+        xarray<int> a = arange<int>(24);
+        a.reshape({2, 3, 4});
+        auto c = cumsum(a, 1);
+        xarray<int> res = c;
+        EXPECT_EQ(res(1, 2, 3), c(1, 2, 3));
+        EXPECT_EQ(res(0, 1, 2), c(0, 1, 2));
+        EXPECT_EQ(res(1, 0, 1), c[xindex({1, 0, 1})]);
+
+        xarray<int> diff = c - a;
+        EXPECT_EQ(0, diff(0, 0, 3));
+        EXPECT_EQ(res(1, 2, 3) - 23, diff(1, 2, 3));
+    }
+
+    TEST(xaccumulator, preallocated)
+    {
+        xtensor<double, 2> a = ones<double>({3, 4});
+        xtensor<double, 2> out = xtensor<double, 2>::from_shape({3, 4});
+        const double* data = out.data().data();
+        noalias(out) = cumsum(a, 0);
+        EXPECT_EQ(data, out.data().data());
+        EXPECT_EQ(3., out(2, 1));
+
+        a = cumsum(a, 1);
+        EXPECT_EQ(4., a(2, 3));
+        EXPECT_EQ(1., a(1, 0));
+    }
+
+    TEST(xaccumulator, long_axis)
+    {
+        std::size_t n = 100000;
+        xarray<double> a = ones<double>({n});
+        xarray<double> res = cumsum(a, 0);
+        EXPECT_EQ(1., res(0));
+        EXPECT_EQ(double(n / 2), res(n / 2 - 1));
+        EXPECT_EQ(double(n), res(n - 1));
+
+        xarray<double> b = ones<double>({std::size_t(2), n});
+        xarray<double> res1 = cummax(cumsum(b, 1), 0);
+        EXPECT_EQ(double(n), res1(1, n - 1));
+    }
+
+    TEST(xaccumulator, axis)
+    {
+        xarray<int> a = {1, 2, 3};
+        EXPECT_THROW(cumsum(a, 1), std::out_of_range);
+    }
+}
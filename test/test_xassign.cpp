@@ -0,0 +1,230 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xadapt.hpp"
+#include "xtensor/xassign.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xmath.hpp"
+#include "xtensor/xnoalias.hpp"
+#include "xtensor/xstridedview.hpp"
+#include "xtensor/xtensor.hpp"
+#include "xtensor/xview.hpp"
+
+namespace xt
+{
+    using std::size_t;
+
+    TEST(xassign, traversal_plan)
+    {
+        xarray<double> a = zeros<double>({3, 1, 4, 5});
+        xarray<double, layout_type::column_major> b = zeros<double>({3, 1, 4, 5});
+
+        auto plan = make_traversal_plan<layout_type::row_major>(a, a + 1.);
+        ASSERT_EQ(3u, plan.nb_dims);
+        EXPECT_FALSE(plan.tiled);
+        EXPECT_EQ(3u, plan.order[0]);
+        EXPECT_EQ(2u, plan.order[1]);
+        EXPECT_EQ(0u, plan.order[2]);
+
+        auto cplan = make_traversal_plan<layout_type::column_major>(b, b * b);
+        ASSERT_EQ(3u, cplan.nb_dims);
+        EXPECT_EQ(0u, cplan.order[0]);
+        EXPECT_EQ(2u, cplan.order[1]);
+        EXPECT_EQ(3u, cplan.order[2]);
+
+        // The rhs is read along the first dimension, the lhs is written
+        // along the last one: small extents are not tiled.
+        auto tplan = make_traversal_plan<layout_type::row_major>(a, b);
+        EXPECT_FALSE(tplan.tiled);
+    }
+
+    TEST(xassign, tiled_plan)
+    {
+        size_t n0 = 3 * XTENSOR_TILE_SIZE + 5, n1 = 2 * XTENSOR_TILE_SIZE + 7;
+        xarray<double> a = arange<double>(double(n0 * n1));
+        a.reshape({n0, n1});
+        xarray<double> res = zeros<double>({n1, n0});
+
+        auto plan = make_traversal_plan<layout_type::row_major>(res, transpose(a));
+        ASSERT_EQ(2u, plan.nb_dims);
+        EXPECT_TRUE(plan.tiled);
+        EXPECT_EQ(1u, plan.order[0]);
+        EXPECT_EQ(0u, plan.order[1]);
+    }
+
+    TEST(xassign, transpose)
+    {
+        size_t n0 = 3 * XTENSOR_TILE_SIZE + 5, n1 = 2 * XTENSOR_TILE_SIZE + 7;
+        xarray<double> a = arange<double>(double(n0 * n1));
+        a.reshape({n0, n1});
+
+        xarray<double> res = transpose(a) * 2.;
+        ASSERT_EQ(n1, res.shape()[0]);
+        ASSERT_EQ(n0, res.shape()[1]);
+        for (size_t i = 0; i < n1; ++i)
+        {
+            for (size_t j = 0; j < n0; ++j)
+            {
+                EXPECT_EQ(2. * a(j, i), res(i, j));
+            }
+        }
+
+        xarray<double, layout_type::column_major> ca = a;
+        xarray<double> ra = ca + 1.;
+        EXPECT_EQ(a + 1., ra);
+    }
+
+    TEST(xassign, transpose_3d)
+    {
+        size_t n0 = 2 * XTENSOR_TILE_SIZE + 3, n1 = 3, n2 = 2 * XTENSOR_TILE_SIZE + 1;
+        xarray<double> a = arange<double>(double(n0 * n1 * n2));
+        a.reshape({n0, n1, n2});
+        xarray<double> b = arange<double>(double(n0));
+
+        xarray<double> res = transpose(a) - b;
+        for (size_t i = 0; i < n2; ++i)
+        {
+            for (size_t j = 0; j < n1; ++j)
+            {
+                for (size_t k = 0; k < n0; ++k)
+                {
+                    EXPECT_EQ(a(k, j, i) - b(k), res(i, j, k));
+                }
+            }
+        }
+    }
+
+    TEST(xassign, unit_dimensions)
+    {
+        xarray<double> a = arange<double>(12.);
+        a.reshape({1, 12, 1});
+        xarray<double> res = a + 1.;
+        EXPECT_EQ(a.shape(), res.shape());
+        for (size_t i = 0; i < 12; ++i)
+        {
+            EXPECT_EQ(double(i) + 1., res(0, i, 0));
+        }
+
+        xarray<double> s = ones<double>({1, 1});
+        xarray<double> sres = s * 3.;
+        EXPECT_EQ(3., sres(0, 0));
+    }
+
+    TEST(xassign, may_alias)
+    {
+        xarray<double> a = ones<double>({3, 4});
+        xarray<double> b = ones<double>({3, 4});
+        xtensor<double, 1> c = ones<double>({4});
+
+        EXPECT_FALSE(may_alias(a, b + c * 2.));
+        EXPECT_FALSE(may_alias(a, transpose(b)));
+        EXPECT_FALSE(may_alias(view(a, 1), view(b, 1) + 1.));
+        EXPECT_TRUE(may_alias(a, b + a));
+        EXPECT_TRUE(may_alias(view(a, 1), view(a, 0)));
+        EXPECT_TRUE(may_alias(a, transpose(a)));
+        EXPECT_TRUE(may_alias(a, b * xcref(a(0, 0))));
+        EXPECT_TRUE(may_alias(a, b + arange<double>(4.)));
+    }
+
+    TEST(xassign, skip_temporary)
+    {
+        xarray<double> a = arange<double>(12.);
+        a.reshape({3, 4});
+        xtensor<double, 1> c = ones<double>({4});
+
+        xarray<double> res = zeros<double>({3, 4});
+        const double* buffer = res.raw_data();
+        res = a + c;
+        EXPECT_EQ(buffer, res.raw_data());
+        EXPECT_EQ(a(2, 3) + 1., res(2, 3));
+
+        res = transpose(res) * 2.;
+        ASSERT_EQ(4u, res.shape()[0]);
+        EXPECT_EQ(2. * (a(1, 3) + 1.), res(3, 1));
+    }
+
+    TEST(xassign, aliasing_scalar)
+    {
+        xarray<double> a = arange<double>(100.);
+        a = a(0) + 1. + a;
+        EXPECT_EQ(1., a(0));
+        EXPECT_EQ(100., a(99));
+
+        xarray<double> b = arange<double>(100.);
+        b = xt::xref(b(0)) + 1. + arange<double>(100.);
+        EXPECT_EQ(1., b(0));
+        EXPECT_EQ(100., b(99));
+
+        xarray<double> c = arange<double>(100.);
+        xarray<double> d = ones<double>({100});
+        c = d + xcref(c(3));
+        EXPECT_EQ(4., c(0));
+        EXPECT_EQ(4., c(99));
+    }
+
+    TEST(xassign, streaming_store)
+    {
+        std::vector<double> src(103), dst(103, 0.);
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            src[i] = double(i);
+        }
+
+        // The destination starts at an odd address to exercise the
+        // alignment of the non-temporal stores
+        double* dst_ptr = dst.data() + 1;
+        double* src_ptr = src.data() + 1;
+        auto a = xadapt(dst_ptr, 101, no_ownership(), std::array<size_t, 1>({101}));
+        auto b = xadapt(src_ptr, 101, no_ownership(), std::array<size_t, 1>({101}));
+        auto f = b * 2.;
+        using loop_type = detail::trivial_loop<detail::use_simd_assign<decltype(a), decltype(f)>::value>;
+        loop_type::run(a, f, size_t(0), size_t(97), true);
+
+        EXPECT_EQ(0., dst[0]);
+        for (size_t i = 1; i < 98; ++i)
+        {
+            EXPECT_EQ(2. * double(i), dst[i]);
+        }
+        EXPECT_EQ(0., dst[98]);
+    }
+
+    TEST(xassign, assign_all)
+    {
+        xarray<double> x = arange<double>(12.);
+        x.reshape({3, 4});
+        xarray<double> y = ones<double>({3, 4});
+        xarray<double> a, b;
+        xtensor<double, 2> c;
+        assign_all(std::tie(a, b, c), std::make_tuple(x + y, x * y, sqrt(x)));
+        EXPECT_EQ(xarray<double>(x + y), a);
+        EXPECT_EQ(xarray<double>(x * y), b);
+        EXPECT_EQ(xarray<double>(sqrt(x)), c);
+
+        xarray<double> row = arange<double>(4.);
+        assign_all(std::tie(a, b), std::make_tuple(x + row, x - row));
+        EXPECT_EQ(xarray<double>(x + row), a);
+        EXPECT_EQ(xarray<double>(x - row), b);
+
+        xarray<double> t = zeros<double>({4, 3});
+        auto tv = transpose(t);
+        assign_all(std::tie(tv, a), std::forward_as_tuple(x, x * 2.));
+        EXPECT_EQ(x(1, 2), t(2, 1));
+        EXPECT_EQ(20., a(2, 2));
+
+        xarray<double> bad = ones<double>({2, 2});
+        xarray<double> a_before = a;
+        xarray<double> b_before = b;
+        EXPECT_THROW(assign_all(std::tie(a, b), std::make_tuple(x + 1., bad + 1.)), broadcast_error);
+        EXPECT_EQ(a_before, a);
+        EXPECT_EQ(b_before, b);
+        EXPECT_THROW(assign_all(std::tie(tv, a), std::make_tuple(bad + 1., x + 1.)), broadcast_error);
+        EXPECT_EQ(a_before, a);
+    }
+}
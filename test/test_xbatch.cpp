@@ -0,0 +1,167 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbatch.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xmath.hpp"
+#include "xtensor/xnoalias.hpp"
+#include "xtensor/xtensor.hpp"
+
+namespace xt
+{
+    TEST(xbatch, simd_interface)
+    {
+        using tensor_type = xtensor<double, 1>;
+        using int_tensor_type = xtensor<int, 1>;
+        tensor_type a = {1., 2.};
+        int_tensor_type b = {1, 2};
+#if defined(XTENSOR_SIMD_AVX) || defined(XTENSOR_SIMD_SSE2)
+        EXPECT_TRUE(has_simd<double>::value);
+        EXPECT_TRUE(has_simd_interface<tensor_type>::value);
+        EXPECT_TRUE(has_simd_interface<decltype(3 * a - 2 * a)>::value);
+        EXPECT_TRUE(has_simd_interface<decltype(sqrt(a) + fmax(a, a))>::value);
+#else
+        EXPECT_FALSE(has_simd<double>::value);
+        EXPECT_FALSE(has_simd_interface<tensor_type>::value);
+        EXPECT_FALSE(has_simd_interface<decltype(3 * a - 2 * a)>::value);
+#endif
+        EXPECT_FALSE(has_simd<int>::value);
+        EXPECT_FALSE(has_simd_interface<int_tensor_type>::value);
+        EXPECT_FALSE(has_simd_interface<decltype(a + b)>::value);
+        EXPECT_FALSE(has_simd_interface<decltype(a < a)>::value);
+    }
+
+#if defined(XTENSOR_SIMD_AVX) || defined(XTENSOR_SIMD_SSE2)
+    TEST(xbatch, arithmetic)
+    {
+        using batch_type = xsimd_batch_t<double>;
+        constexpr std::size_t size = batch_type::size;
+        double va[size], vb[size], res[size];
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            va[i] = double(i) + 1.;
+            vb[i] = 2. * double(i) - 3.;
+        }
+        batch_type a = batch_type::load_unaligned(va);
+        batch_type b = batch_type::load_unaligned(vb);
+
+        (a * b - a / b + (-a)).store_unaligned(res);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_DOUBLE_EQ(va[i] * vb[i] - va[i] / vb[i] - va[i], res[i]);
+        }
+
+        fma(a, b, batch_type(1.)).store_unaligned(res);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_DOUBLE_EQ(std::fma(va[i], vb[i], 1.), res[i]);
+        }
+
+        select(a < b, abs(b), sqrt(a)).store_unaligned(res);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_DOUBLE_EQ(va[i] < vb[i] ? std::abs(vb[i]) : std::sqrt(va[i]), res[i]);
+        }
+
+        exp(a).store_unaligned(res);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_DOUBLE_EQ(std::exp(va[i]), res[i]);
+        }
+    }
+
+    TEST(xbatch, masks)
+    {
+        using batch_type = xsimd_batch_t<float>;
+        constexpr std::size_t size = batch_type::size;
+        float va[size];
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            va[i] = float(i);
+        }
+        batch_type a = batch_type::load_unaligned(va);
+        EXPECT_TRUE(any(a > batch_type(0.f)));
+        EXPECT_FALSE(all(a > batch_type(0.f)));
+        EXPECT_TRUE(all(a >= batch_type(0.f)));
+        EXPECT_FALSE(any(a != a));
+        int mask = (a < batch_type(1.5f)).mask();
+        int inverted_mask = (~(a < batch_type(1.5f))).mask();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            bool lane = (mask >> i) & 1;
+            bool inverted_lane = (inverted_mask >> i) & 1;
+            EXPECT_EQ(i < 2, lane);
+            EXPECT_EQ(i >= 2, inverted_lane);
+        }
+        EXPECT_EQ(float(size - 1), hmax(a));
+        EXPECT_EQ(0.f, hmin(a));
+        EXPECT_EQ(float(size * (size - 1) / 2), hadd(a));
+    }
+
+    TEST(xbatch, nan)
+    {
+        using batch_type = xsimd_batch_t<double>;
+        constexpr std::size_t size = batch_type::size;
+        double nan = std::numeric_limits<double>::quiet_NaN();
+        double va[size], vb[size], res[size];
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            va[i] = i % 2 == 0 ? nan : double(i);
+            vb[i] = i % 3 == 0 ? nan : 1.;
+        }
+        batch_type a = batch_type::load_unaligned(va);
+        batch_type b = batch_type::load_unaligned(vb);
+        EXPECT_TRUE(any(isnan(a)));
+
+        fmin(a, b).store_unaligned(res);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            double expected = std::fmin(va[i], vb[i]);
+            EXPECT_TRUE(std::isnan(expected) ? std::isnan(res[i]) : expected == res[i]);
+        }
+
+        fmax(a, b).store_unaligned(res);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            double expected = std::fmax(va[i], vb[i]);
+            EXPECT_TRUE(std::isnan(expected) ? std::isnan(res[i]) : expected == res[i]);
+        }
+    }
+#endif
+
+    TEST(xbatch, assign)
+    {
+        std::size_t size = 1003;
+        xtensor<double, 1> x = arange<double>(double(size));
+        xtensor<double, 1> y = ones<double>({size});
+        xtensor<double, 1> res(x.shape());
+        noalias(res) = 3 * x - 2 * y;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(3. * double(i) - 2., res(i));
+        }
+
+        xarray<float> fx = arange<float>(float(size));
+        xarray<float> fres = sqrt(fx) + maximum(fx, 10.f) / 2.f;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_FLOAT_EQ(std::sqrt(float(i)) + std::max(float(i), 10.f) / 2.f, fres(i));
+        }
+
+        xarray<double> bres = broadcast(x, {size}) * x;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(double(i) * double(i), bres(i));
+        }
+    }
+}
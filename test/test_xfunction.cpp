@@ -82,6 +82,77 @@ namespace xt
         }
     }
 
+    TEST(xfunction, cached_broadcast)
+    {
+        using shape_type = layout_result<>::shape_type;
+        xfunction_features f;
+
+        auto same = f.m_a + f.m_a;
+        EXPECT_TRUE(same.has_trivial_broadcast());
+        auto different = f.m_a + f.m_b;
+        EXPECT_FALSE(different.has_trivial_broadcast());
+
+        // The cached shape must give the same results as the arguments
+        shape_type sh(3, size_t(1));
+        EXPECT_TRUE(same.broadcast_shape(sh));
+        EXPECT_EQ(f.m_a.shape(), sh);
+        shape_type sh2(3, size_t(1));
+        EXPECT_FALSE(different.broadcast_shape(sh2));
+        EXPECT_EQ(f.m_a.shape(), sh2);
+        shape_type sh3(4, size_t(1));
+        EXPECT_FALSE(same.broadcast_shape(sh3));
+        EXPECT_EQ(f.m_c.shape(), (f.m_c + same).shape());
+        EXPECT_FALSE(different.is_trivial_broadcast(f.m_a.strides()));
+
+        xarray<int> res;
+        for (int i = 0; i < 2; ++i)
+        {
+            res = different;
+            EXPECT_EQ(f.m_a(1, 1, 2) + f.m_b(1, 0, 2), res(1, 1, 2));
+        }
+
+        xarray<int> bad = {1, 2};
+        EXPECT_THROW((f.m_a + bad).shape(), broadcast_error);
+    }
+
+    TEST(xfunction, is_mergeable)
+    {
+        using shape_type = layout_result<>::shape_type;
+        xfunction_features f;
+        shape_type sh = f.m_a.shape();
+
+        EXPECT_TRUE(is_mergeable(f.m_a + f.m_a, sh, 0, 1));
+        EXPECT_TRUE(is_mergeable(f.m_a + f.m_a, sh, 1, 2));
+        EXPECT_TRUE(is_mergeable(f.m_a + 2, sh, 1, 2));
+        EXPECT_FALSE(is_mergeable(f.m_a + f.m_b, sh, 0, 1));
+        EXPECT_FALSE(is_mergeable(f.m_a + f.m_b, sh, 1, 2));
+    }
+
+    TEST(xfunction, broadcast_assign)
+    {
+        xfunction_features f;
+        xarray<int> res = f.m_c + f.m_b;
+        xarray<int, layout_type::column_major> cres = f.m_c + f.m_b;
+        xarray<int> sres = f.m_a * 2 - f.m_b;
+        auto sh = f.m_c.shape();
+        for (size_t i = 0; i < sh[0]; ++i)
+        {
+            for (size_t j = 0; j < sh[1]; ++j)
+            {
+                for (size_t k = 0; k < sh[2]; ++k)
+                {
+                    for (size_t l = 0; l < sh[3]; ++l)
+                    {
+                        int expected = f.m_c(i, j, k, l) + f.m_b(j, 0, l);
+                        EXPECT_EQ(expected, res(i, j, k, l));
+                        EXPECT_EQ(expected, cres(i, j, k, l));
+                        EXPECT_EQ(f.m_a(j, k, l) * 2 - f.m_b(j, 0, l), sres(j, k, l));
+                    }
+                }
+            }
+        }
+    }
+
     TEST(xfunction, layout_type)
     {
         xarray<int, layout_type::dynamic> m_d;
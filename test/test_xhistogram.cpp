@@ -0,0 +1,110 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xhistogram.hpp"
+#include "xtensor/xtensor.hpp"
+#include "xtensor/xview.hpp"
+
+namespace xt
+{
+    TEST(xhistogram, bincount)
+    {
+        xarray<int> a = {{1, 3, 1}, {0, 7, 3}};
+        xtensor<std::size_t, 1> expected = {1, 2, 0, 2, 0, 0, 0, 1};
+        EXPECT_EQ(expected, bincount(a));
+        EXPECT_EQ(10u, bincount(a, 10).size());
+        EXPECT_EQ(8u, bincount(a, 3).size());
+
+        xarray<double> w = {{0.5, 1., 2.}, {4., 8., 16.}};
+        auto wc = bincount(a, w);
+        EXPECT_EQ(8u, wc.size());
+        EXPECT_DOUBLE_EQ(4., wc(0));
+        EXPECT_DOUBLE_EQ(2.5, wc(1));
+        EXPECT_DOUBLE_EQ(17., wc(3));
+        EXPECT_DOUBLE_EQ(8., wc(7));
+
+        xarray<int, layout_type::column_major> b = a;
+        EXPECT_EQ(wc, bincount(b, w));
+
+        xarray<int> neg = {1, -1};
+        EXPECT_THROW(bincount(neg), std::runtime_error);
+    }
+
+    TEST(xhistogram, uniform)
+    {
+        xarray<double> a = {0., 0.1, 0.25, 0.5, 0.7, 0.99, 1., 1.5, -0.2};
+        xtensor<std::size_t, 1> h = histogram(a, 4, 0., 1.);
+        xtensor<std::size_t, 1> expected = {2, 1, 2, 2};
+        EXPECT_EQ(expected, h);
+
+        xtensor<std::size_t, 1> h10 = histogram(a, 10, 0., 1.);
+        EXPECT_EQ(1u, h10(6));
+        EXPECT_EQ(1u, h10(2));
+
+        xtensor<std::size_t, 1> hr = histogram(a, 2);
+        EXPECT_EQ(5u, hr(0));
+        EXPECT_EQ(4u, hr(1));
+        auto edges = histogram_bin_edges(a, 2);
+        EXPECT_DOUBLE_EQ(-0.2, edges(0));
+        EXPECT_DOUBLE_EQ(0.65, edges(1));
+        EXPECT_DOUBLE_EQ(1.5, edges(2));
+
+        EXPECT_THROW(histogram(a, 0, 0., 1.), std::runtime_error);
+        EXPECT_THROW(histogram(a, 2, 1., 1.), std::runtime_error);
+    }
+
+    TEST(xhistogram, edges)
+    {
+        xarray<int> a = arange<int>(10);
+        xtensor<double, 1> edges = {0., 1., 5., 9.};
+        xtensor<std::size_t, 1> expected = {1, 4, 5};
+        EXPECT_EQ(expected, histogram(a, edges));
+        EXPECT_EQ(histogram(a, 3, 0., 9.), histogram(a, xtensor<double, 1>({0., 3., 6., 9.})));
+        EXPECT_EQ(expected, histogram(a * 1, edges));
+        EXPECT_EQ(expected, histogram(arange<int>(10), edges));
+
+        xtensor<double, 1> unsorted = {0., 2., 1.};
+        EXPECT_THROW(histogram(a, unsorted), std::runtime_error);
+    }
+
+    TEST(xhistogram, axis)
+    {
+        xarray<double> a = {{0., 1., 2., 3.}, {3., 3., 3., 0.5}};
+        xarray<std::size_t> h1 = histogram(a, 2, 0., 3., 1);
+        EXPECT_EQ(xarray<std::size_t>({{2, 2}, {1, 3}}), h1);
+        xarray<std::size_t> h0 = histogram(a, 3, 0., 3., 0);
+        std::vector<std::size_t> shape = {4, 3};
+        EXPECT_TRUE(std::equal(shape.cbegin(), shape.cend(), h0.shape().cbegin()));
+        EXPECT_EQ(xarray<std::size_t>({1, 0, 1}), view(h0, 0, all()));
+        EXPECT_EQ(xarray<std::size_t>({0, 1, 1}), view(h0, 1, all()));
+        EXPECT_EQ(xarray<std::size_t>({1, 0, 1}), view(h0, 3, all()));
+    }
+
+    TEST(xhistogram, large)
+    {
+        std::size_t n = 100000;
+        xtensor<int, 1> a = xtensor<int, 1>::from_shape({n});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            a(i) = int(i % 10);
+        }
+        auto c = bincount(a);
+        auto h = histogram(a, 5, 0., 10.);
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            EXPECT_EQ(n / 10, c(i));
+        }
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            EXPECT_EQ(n / 5, h(i));
+        }
+    }
+}
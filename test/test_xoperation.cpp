@@ -10,6 +10,7 @@
 
 #include <cstddef>
 #include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
 #include "xtensor/xtensor.hpp"
 
 namespace xt
@@ -315,6 +316,42 @@ namespace xt
         EXPECT_EQ(false, all(b));
     }
 
+    TYPED_TEST(operation, argwhere_first)
+    {
+        using int_container_2d = rebind_container_t<TypeParam, int>;
+        int_container_2d a = {{0, 0, 0}, {0, 4, 5}};
+        EXPECT_EQ(4u, argwhere_first(a));
+        EXPECT_EQ(6u, argwhere_first(a > 5));
+        EXPECT_EQ(5u, argwhere_first(a > 4));
+
+        xarray<int, layout_type::column_major> b = a;
+        EXPECT_EQ(4u, argwhere_first(b));
+        xarray<int> row = {0, 0, 1};
+        EXPECT_EQ(2u, argwhere_first(a * 0 + row));
+    }
+
+    TYPED_TEST(operation, any_all_long)
+    {
+        xarray<double> a = xarray<double>::from_shape({3, 100});
+        std::fill(a.begin(), a.end(), 1.);
+        EXPECT_FALSE(any(a > 1.));
+        EXPECT_TRUE(all(a > 0.));
+        a(2, 70) = 2.;
+        EXPECT_TRUE(any(a > 1.));
+        EXPECT_FALSE(all(a < 2.));
+        EXPECT_EQ(270u, argwhere_first(a > 1.));
+
+        xarray<double> col = xarray<double>::from_shape({3, 1});
+        std::fill(col.begin(), col.end(), 0.);
+        EXPECT_TRUE(any(a + col > 1.));
+        EXPECT_FALSE(all(a + col < 2.));
+        EXPECT_EQ(270u, argwhere_first(a + col > 1.));
+
+        EXPECT_TRUE(any(arange<int>(3)));
+        EXPECT_FALSE(all(arange<int>(3)));
+        EXPECT_EQ(1u, argwhere_first(arange<int>(3)));
+    }
+
     TYPED_TEST(operation, all_layout)
     {
         xarray<int, layout_type::row_major> a = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
@@ -323,6 +360,25 @@ namespace xt
         EXPECT_TRUE(all(equal(a, b)));
     }
 
+    TYPED_TEST(operation, any_all_axis)
+    {
+        xarray<int> a = {{0, 0, 3}, {1, 2, 0}};
+        EXPECT_EQ(xarray<bool>({true, true, true}), any(a, 0));
+        EXPECT_EQ(xarray<bool>({true, true}), any(a, 1));
+        EXPECT_EQ(xarray<bool>({false, false, false}), all(a, 0));
+        EXPECT_EQ(xarray<bool>({false, false}), all(a, 1));
+        EXPECT_EQ(xarray<bool>({false, true}), all(a + 1 > 0 && a < 3, 1));
+        EXPECT_EQ(xarray<bool>({false, true, false}), any(equal(a, 2), 0));
+
+        xarray<int, layout_type::column_major> b = a;
+        EXPECT_EQ(any(a > 1, 1), any(b > 1, 1));
+
+        xarray<double> e = xarray<double>::from_shape({2, 0});
+        EXPECT_EQ(xarray<bool>({false, false}), any(e, 1));
+        EXPECT_EQ(xarray<bool>({true, true}), all(e, 1));
+        EXPECT_THROW(any(a, 2), std::out_of_range);
+    }
+
     TYPED_TEST(operation, nonzero)
     {
         using int_container_2d = rebind_container_t<TypeParam, int>;
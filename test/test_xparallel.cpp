@@ -0,0 +1,145 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xnoalias.hpp"
+#include "xtensor/xparallel.hpp"
+#include "xtensor/xstridedview.hpp"
+#include "xtensor/xtensor.hpp"
+
+namespace xt
+{
+    struct num_threads_guard
+    {
+        explicit num_threads_guard(std::size_t n)
+            : m_old(get_num_threads())
+        {
+            set_num_threads(n);
+        }
+
+        ~num_threads_guard()
+        {
+            set_num_threads(m_old);
+        }
+
+        std::size_t m_old;
+    };
+
+    TEST(xparallel, parallel_for)
+    {
+        num_threads_guard guard(4);
+        std::size_t size = 100000;
+        std::vector<int> v(size, 0);
+        parallel_for(size, 1000, [&v](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                v[i] += int(i % 7);
+            }
+        });
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(int(i % 7), v[i]);
+        }
+    }
+
+    TEST(xparallel, chunk_count)
+    {
+        num_threads_guard guard(4);
+        EXPECT_EQ(1u, parallel_chunk_count(10, 100));
+#ifdef XTENSOR_USE_THREADS
+        EXPECT_EQ(4u, get_num_threads());
+        EXPECT_EQ(2u, parallel_chunk_count(250, 100));
+        EXPECT_EQ(4u, parallel_chunk_count(100000, 100));
+#else
+        EXPECT_EQ(1u, get_num_threads());
+        EXPECT_EQ(1u, parallel_chunk_count(100000, 100));
+#endif
+    }
+
+    TEST(xparallel, nested)
+    {
+        num_threads_guard guard(4);
+        std::atomic<std::size_t> count(0);
+        parallel_for_each_chunk(4, [&count](std::size_t) {
+            parallel_for_each_chunk(4, [&count](std::size_t) { ++count; });
+        });
+        EXPECT_EQ(16u, count.load());
+    }
+
+    TEST(xparallel, exception)
+    {
+        num_threads_guard guard(4);
+        auto f = [](std::size_t i) {
+            if (i == 2)
+            {
+                throw std::runtime_error("chunk failure");
+            }
+        };
+        EXPECT_THROW(parallel_for_each_chunk(4, f), std::runtime_error);
+    }
+
+    TEST(xparallel, trivial_assign)
+    {
+        num_threads_guard guard(4);
+        std::size_t size = 4 * XTENSOR_PARALLEL_GRAIN_SIZE + 3;
+        xtensor<double, 1> a = arange<double>(double(size));
+        xtensor<double, 1> b = ones<double>({size});
+        xtensor<double, 1> res(a.shape());
+        noalias(res) = 3 * a - 2 * b;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(3. * double(i) - 2., res(i));
+        }
+    }
+
+    TEST(xparallel, broadcast_assign)
+    {
+        num_threads_guard guard(4);
+        std::size_t size0 = 97, size1 = 2 * XTENSOR_PARALLEL_GRAIN_SIZE / 97 + 11;
+        xarray<double> a = ones<double>({size0, size1});
+        xarray<double> col = arange<double>(double(size0));
+        col.reshape({size0, 1});
+
+        xarray<double> res = a + col;
+        ASSERT_EQ(size0, res.shape()[0]);
+        ASSERT_EQ(size1, res.shape()[1]);
+        for (std::size_t i = 0; i < size0; ++i)
+        {
+            for (std::size_t j = 0; j < size1; ++j)
+            {
+                EXPECT_EQ(1. + double(i), res(i, j));
+            }
+        }
+
+        xarray<double, layout_type::column_major> cres = a + col;
+        EXPECT_EQ(res, cres);
+    }
+
+    TEST(xparallel, transpose_assign)
+    {
+        num_threads_guard guard(4);
+        std::size_t size0 = 301, size1 = 2 * XTENSOR_PARALLEL_GRAIN_SIZE / 301 + 13;
+        xarray<double> a = arange<double>(double(size0 * size1));
+        a.reshape({size0, size1});
+
+        xarray<double> res = transpose(a) + 1.;
+        for (std::size_t i = 0; i < size1; ++i)
+        {
+            for (std::size_t j = 0; j < size0; ++j)
+            {
+                EXPECT_EQ(a(j, i) + 1., res(i, j));
+            }
+        }
+    }
+}
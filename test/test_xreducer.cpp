@@ -6,6 +6,8 @@
 * The full license is in the file LICENSE, distributed with this software. *
 ****************************************************************************/
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "xtensor/xarray.hpp"
 #include "xtensor/xtensor.hpp"
@@ -104,6 +106,34 @@ namespace xt
         EXPECT_EQ(expectedv1, resv1);
     }
 
+    TEST(xreducer, fixed_axes)
+    {
+        xtensor<double, 3> a = xtensor<double, 3>::from_shape({2, 3, 4});
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            a.data()[i] = double(i);
+        }
+
+        auto r1 = sum<1>(a);
+        using shape_type = typename decltype(r1)::shape_type;
+        EXPECT_TRUE((std::is_same<shape_type, std::array<std::size_t, 2>>::value));
+        xtensor<double, 2> res1 = r1;
+        xarray<double> expected1 = sum(a, {1});
+        EXPECT_EQ(expected1, res1);
+
+        xtensor<double, 1> res02 = sum<0, 2>(a);
+        xarray<double> expected02 = sum(a, {0, 2});
+        EXPECT_EQ(expected02, res02);
+
+        xtensor<double, 1> res_reduce = reduce<0, 1>(std::plus<double>(), a + 1.);
+        xarray<double> expected_reduce = sum(a + 1., {0, 1});
+        EXPECT_EQ(expected_reduce, res_reduce);
+
+        xtensor<double, 2> res_mean = mean<2>(a);
+        xarray<double> expected_mean = mean(a, {2});
+        EXPECT_EQ(expected_mean, res_mean);
+    }
+
     TEST(xreducer, sum_all)
     {
         xreducer_features features;
@@ -112,6 +142,135 @@ namespace xt
         EXPECT_EQ(res(), expected);
     }
 
+    TEST(xreducer, contiguous_axes)
+    {
+        xarray<double> a = arange<double>(210);
+        a.reshape({5, 6, 7});
+        xarray<double, layout_type::column_major> b = a;
+
+        // The assignment of a reducer to a container and the access to its
+        // elements through a stepper must give the same results.
+        xarray<double> res0 = sum(a, {1, 2});
+        xarray<double> res1 = sum(a, {2});
+        xarray<double> res2 = sum(b, {0, 1});
+        xarray<double, layout_type::column_major> res3 = sum(a, {2});
+        xarray<double> res4 = amax(a + b, {1, 2});
+        EXPECT_EQ(res0, sum(a, {1, 2}) + 0.);
+        EXPECT_EQ(res1, sum(a, {2}) + 0.);
+        EXPECT_EQ(res2, sum(b, {0, 1}) + 0.);
+        EXPECT_EQ(res3, sum(a, {2}) + 0.);
+        EXPECT_EQ(res4, amax(a + b, {1, 2}) + 0.);
+        EXPECT_EQ(sum(a, {2})(3, 4), 3 * 294 + 4 * 49 + 21.);
+        EXPECT_EQ(sum(a)(), 209. * 105.);
+        EXPECT_EQ(sum(b)(), 209. * 105.);
+
+        xarray<double> c = arange<double>(60);
+        c.reshape({3, 20});
+        xarray<double> res5 = prod(c / 60. + 1., {1});
+        xarray<double> res6 = amin(c, {1});
+        EXPECT_NEAR(res5(1), (prod(c / 60. + 1., {1}) + 0.)(1), 1e-12);
+        EXPECT_EQ(res6, amin(c, {1}) + 0.);
+    }
+
+    TEST(xreducer, storage_order)
+    {
+        xarray<double> a = arange<double>(210);
+        a.reshape({5, 6, 7});
+        xarray<double, layout_type::column_major> b = a;
+
+        xarray<double> res0 = sum(a, {0});
+        xarray<double> res1 = sum(a, {1});
+        xarray<double> res2 = sum(a, {0, 2});
+        xarray<double> res3 = amax(b, {1, 2});
+        xarray<double, layout_type::column_major> res4 = amin(b - a, {1});
+        xarray<float> af = arange<float>(210);
+        af.reshape({5, 6, 7});
+        xarray<double> res5 = sum(af, {0, 2});
+        EXPECT_EQ(res0, sum(a, {0}) + 0.);
+        EXPECT_EQ(res1, sum(a, {1}) + 0.);
+        EXPECT_EQ(res2, sum(a, {0, 2}) + 0.);
+        EXPECT_EQ(res3, amax(b, {1, 2}) + 0.);
+        EXPECT_EQ(res4, amin(b - a, {1}) + 0.);
+        EXPECT_EQ(res5, res2);
+
+        using axes_type = std::array<std::size_t, 1>;
+        xarray<double> res6 = xreducer<std::plus<double>, const xarray<double>&, axes_type>(std::plus<double>(), a, axes_type({1}));
+        EXPECT_EQ(res6, res1);
+
+        xtensor<double, 2> c = ones<double>({1000, 3});
+        xtensor<double, 1> res7 = sum(c, {0});
+        EXPECT_EQ(res7, (xtensor<double, 1>{1000., 1000., 1000.}));
+    }
+
+    TEST(xreducer, parallel)
+    {
+        std::size_t old_nb_threads = get_num_threads();
+        xarray<double> a = 1. / (arange<double>(300000) + 1.);
+        a.reshape({1000, 30, 10});
+        xarray<double> v = a;
+        v.reshape({300000});
+
+        set_num_threads(1);
+        double serial_all = sum(v)();
+        xarray<double> serial0 = sum(a, {0});
+        xarray<double> serial1 = sum(a, {1, 2});
+
+        set_num_threads(4);
+        EXPECT_NEAR(serial_all, sum(v)(), 1e-10);
+        xarray<double> res0 = sum(a, {0});
+        xarray<double> res1 = sum(a, {1, 2});
+        EXPECT_TRUE(allclose(res0, serial0));
+        EXPECT_EQ(res1, serial1);
+        EXPECT_EQ(amax(a, {0, 1})(0), 1.);
+
+        set_deterministic_reductions(true);
+        set_num_threads(1);
+        double det_all1 = sum(v)();
+        xarray<double> det1 = sum(a, {0, 2});
+        set_num_threads(4);
+        double det_all4 = sum(v)();
+        xarray<double> det4 = sum(a, {0, 2});
+        set_num_threads(3);
+        double det_all3 = sum(v)();
+        set_deterministic_reductions(false);
+        set_num_threads(old_nb_threads);
+
+        EXPECT_EQ(det_all1, det_all4);
+        EXPECT_EQ(det_all1, det_all3);
+        EXPECT_EQ(det1, det4);
+        EXPECT_NEAR(serial_all, det_all1, 1e-10);
+    }
+
+    TEST(xreducer, summation)
+    {
+        std::size_t size = 1 << 20;
+        xarray<float> a = ones<float>({size}) * 0.1f;
+        double expected = double(0.1f) * double(size);
+        double tolerance = expected * 1e-6;
+        EXPECT_NEAR(expected, sum<summation::pairwise>(a)(), tolerance);
+        EXPECT_NEAR(expected, sum<summation::kahan>(a)(), tolerance);
+        EXPECT_NEAR(0.1, mean<summation::pairwise>(a)(), 1e-7);
+        EXPECT_NEAR(0.1, mean<summation::kahan>(a)(), 1e-7);
+
+        a.reshape({size / 8, 8});
+        xarray<float> pairwise0 = sum<summation::pairwise>(a, {0});
+        xarray<float> kahan0 = sum<summation::kahan>(a, {0});
+        xarray<float> stepper0 = sum<summation::pairwise>(a, {0}) + 0.f;
+        xarray<float> stepper1 = sum<summation::kahan>(a, {0}) + 0.f;
+        EXPECT_NEAR(expected / 8, pairwise0(3), tolerance / 8);
+        EXPECT_NEAR(expected / 8, kahan0(3), tolerance / 8);
+        EXPECT_NEAR(expected / 8, stepper0(3), tolerance / 8);
+        EXPECT_NEAR(expected / 8, stepper1(3), tolerance / 8);
+
+        xarray<double> b = arange<double>(210);
+        b.reshape({5, 6, 7});
+        xarray<double> res = sum(b, {0, 2});
+        xarray<double> res_pairwise = sum<summation::pairwise>(b, {0, 2});
+        xarray<double> res_kahan = mean<summation::kahan>(b, {0, 2});
+        EXPECT_EQ(res, res_pairwise);
+        EXPECT_EQ(res / 35., res_kahan);
+    }
+
     TEST(xreducer, mean)
     {
         xtensor<double, 2> input
@@ -128,4 +287,180 @@ namespace xt
         EXPECT_TRUE(all(equal(mean0, expect0)));
         EXPECT_TRUE(all(equal(mean1, expect1)));
     }
+
+    TEST(xreducer, functors)
+    {
+        xarray<double> a = arange<double>(24);
+        a.reshape({2, 3, 4});
+        xarray<double, layout_type::column_major> b = a;
+
+        auto count = make_xreducer_functor([](std::size_t c, double v) { return c + std::size_t(v > 10.); },
+                                           const_value<std::size_t>(0), std::plus<std::size_t>());
+        xarray<std::size_t> expected_count = {4, 4, 5};
+        xarray<std::size_t> res_count = reduce(count, a, {0, 2});
+        xarray<std::size_t> res_count_stepper = reduce(count, a + 0., {0, 2});
+        EXPECT_EQ(expected_count, res_count);
+        EXPECT_EQ(expected_count, res_count_stepper);
+        EXPECT_EQ(13u, reduce(count, a)());
+
+        // The index is the flat position over the reduced axes, in row-major order.
+        auto weighted = make_xreducer_functor([](std::size_t c, double v, std::size_t i) { return c + std::size_t(v > 10.) * i; },
+                                              const_value<std::size_t>(0), std::plus<std::size_t>());
+        xarray<std::size_t> expected_weighted = {22, 22, 25};
+        xarray<std::size_t> res_weighted = reduce(weighted, a, {0, 2});
+        xarray<std::size_t> res_weighted_cm = reduce(weighted, b, {0, 2});
+        xarray<std::size_t> res_weighted_stepper = reduce(weighted, a + 0., {0, 2});
+        EXPECT_EQ(expected_weighted, res_weighted);
+        EXPECT_EQ(expected_weighted, res_weighted_cm);
+        EXPECT_EQ(expected_weighted, res_weighted_stepper);
+        EXPECT_EQ(221u, reduce(weighted, a)());
+        EXPECT_EQ(221u, reduce(weighted, b)());
+
+        xarray<double> empty = xarray<double>::from_shape({2, 0});
+        xarray<std::size_t> res_empty = reduce(count, empty, {1});
+        EXPECT_EQ(xarray<std::size_t>({0, 0}), res_empty);
+    }
+
+    TEST(xreducer, count_nonzero)
+    {
+        xarray<int> a = {{1, 0, 3}, {0, 0, 7}};
+        EXPECT_EQ(3u, count_nonzero(a)());
+        xarray<std::size_t> res0 = count_nonzero(a, {0});
+        xarray<std::size_t> res1 = count_nonzero(a, {1});
+        EXPECT_EQ(xarray<std::size_t>({1, 0, 2}), res0);
+        EXPECT_EQ(xarray<std::size_t>({2, 1}), res1);
+    }
+
+    TEST(xreducer, argmax)
+    {
+        xarray<double> a = {{1., -5., 3.}, {7., 2., 7.}};
+        xarray<double, layout_type::column_major> b = a;
+        EXPECT_EQ(3u, argmax(a)());
+        EXPECT_EQ(3u, argmax(b)());
+        EXPECT_EQ(3u, argmax(a + 0.)());
+        EXPECT_EQ(1u, argmin(a)());
+
+        xarray<std::size_t> res0 = argmax(a, 0);
+        xarray<std::size_t> res1 = argmax(a, 1);
+        xarray<std::size_t> res1_cm = argmax(b, 1);
+        xarray<std::size_t> res1_stepper = argmin(a + 0., 1);
+        EXPECT_EQ(xarray<std::size_t>({1, 1, 1}), res0);
+        EXPECT_EQ(xarray<std::size_t>({2, 0}), res1);
+        EXPECT_EQ(xarray<std::size_t>({2, 0}), res1_cm);
+        EXPECT_EQ(xarray<std::size_t>({1, 1}), res1_stepper);
+
+        xarray<int> c = xarray<int>::from_shape({3, 1000});
+        for (std::size_t i = 0; i < c.size(); ++i)
+        {
+            c.data()[i] = int((i * 7919) % 1013);
+        }
+        EXPECT_EQ(564u, argmax(c)());
+        EXPECT_EQ(0u, argmin(c)());
+    }
+
+    TEST(xreducer, norms)
+    {
+        xarray<double> a = {{1., -5., 3.}, {7., 2., 7.}};
+        EXPECT_EQ(25., norm_l1(a)());
+        EXPECT_EQ(137., norm_sq(a)());
+        EXPECT_DOUBLE_EQ(std::sqrt(137.), norm_l2(a)());
+        EXPECT_EQ(7., norm_linf(a)());
+
+        xarray<double> res_l1 = norm_l1(a, {1});
+        xarray<double> res_linf = norm_linf(a + 0., {0});
+        EXPECT_EQ(xarray<double>({9., 16.}), res_l1);
+        EXPECT_EQ(xarray<double>({7., 5., 7.}), res_linf);
+
+        xarray<std::complex<double>> z = {std::complex<double>(3., 4.), std::complex<double>(0., -12.)};
+        EXPECT_DOUBLE_EQ(13., norm_l2(z)());
+        EXPECT_DOUBLE_EQ(17., norm_l1(z)());
+
+        EXPECT_DOUBLE_EQ(25., norm_lp(a, 1.)());
+        EXPECT_DOUBLE_EQ(std::sqrt(137.), norm_lp(a, 2.)());
+        xarray<double> res_lp = norm_lp(a, 3., {1});
+        EXPECT_NEAR(std::cbrt(153.), res_lp(0), 1e-12);
+        EXPECT_NEAR(std::cbrt(694.), res_lp(1), 1e-12);
+
+        xarray<double> res_scaled = norm_l2_scaled(a, {0});
+        EXPECT_DOUBLE_EQ(std::sqrt(50.), res_scaled(0));
+        EXPECT_DOUBLE_EQ(std::sqrt(29.), res_scaled(1));
+        EXPECT_DOUBLE_EQ(std::sqrt(58.), res_scaled(2));
+        xarray<double> big = {3e200, -4e200};
+        EXPECT_DOUBLE_EQ(5e200, norm_l2_scaled(big)());
+        EXPECT_DOUBLE_EQ(0., norm_l2_scaled(xarray<double>::from_shape({0}))());
+
+        xarray<int> ia = {3, -4};
+        EXPECT_DOUBLE_EQ(5., norm_lp(ia, 2.)());
+        EXPECT_DOUBLE_EQ(std::cbrt(91.), norm_lp(ia, 3.)());
+        EXPECT_DOUBLE_EQ(5., norm_l2_scaled(ia)());
+        xarray<int> ib = {{1, -5, 3}, {7, 2, 7}};
+        xarray<double> res_int_lp = norm_lp(ib, 2., {1});
+        xarray<double> res_int_scaled = norm_l2_scaled(ib, {0});
+        EXPECT_DOUBLE_EQ(std::sqrt(35.), res_int_lp(0));
+        EXPECT_DOUBLE_EQ(std::sqrt(102.), res_int_lp(1));
+        EXPECT_DOUBLE_EQ(std::sqrt(50.), res_int_scaled(0));
+        EXPECT_DOUBLE_EQ(std::sqrt(29.), res_int_scaled(1));
+        EXPECT_THROW(norm_lp(a, 0.), std::invalid_argument);
+        EXPECT_THROW(norm_lp(a, -1., {0}), std::invalid_argument);
+
+        xarray<double> c = xarray<double>::from_shape({3, 1001});
+        for (std::size_t i = 0; i < c.size(); ++i)
+        {
+            c.data()[i] = double(int(i % 17) - 8);
+        }
+        xarray<double> c_l1 = norm_l1(c, {1});
+        xarray<double> c_sq = norm_sq(c, {1});
+        xarray<double> c_linf = norm_linf(c, {0});
+        xarray<double> c_l1_stepper = norm_l1(c + 0., {1});
+        xarray<double> c_sq_stepper = norm_sq(c + 0., {1});
+        xarray<double> c_linf_stepper = norm_linf(c + 0., {0});
+        EXPECT_EQ(c_l1_stepper, c_l1);
+        EXPECT_EQ(c_sq_stepper, c_sq);
+        EXPECT_EQ(c_linf_stepper, c_linf);
+    }
+
+    TEST(xreducer, broadcast)
+    {
+        xarray<double> a = {{1., 2., 3.}, {4., 6., 8.}};
+        xarray<double> centered = a - mean(a, {0});
+        EXPECT_EQ(xarray<double>({{-1.5, -2., -2.5}, {1.5, 2., 2.5}}), centered);
+
+        xarray<double> col = xarray<double>::from_shape({2, 1});
+        col(0, 0) = 1.;
+        col(1, 0) = 2.;
+        xarray<double> outer = col * sum(a, {0});
+        EXPECT_EQ(xarray<double>({{5., 8., 11.}, {10., 16., 22.}}), outer);
+
+        auto red = sum(a, {0});
+        xarray<double> twice = red + red;
+        EXPECT_EQ(xarray<double>({10., 16., 22.}), twice);
+    }
+
+    template <layout_type L>
+    void check_broadcast_layout()
+    {
+        using shape_type = std::vector<std::size_t>;
+        xarray<double, L> a(shape_type({2, 3, 4}));
+        std::iota(a.begin(), a.end(), 0.);
+        xarray<double, layout_type::row_major> row_res = a - sum(a, {0});
+        xarray<double, layout_type::column_major> col_res = a - sum(a, {0});
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    double expected = a(i, j, k) - a(0, j, k) - a(1, j, k);
+                    EXPECT_EQ(expected, row_res(i, j, k));
+                    EXPECT_EQ(expected, col_res(i, j, k));
+                }
+            }
+        }
+    }
+
+    TEST(xreducer, broadcast_layout)
+    {
+        check_broadcast_layout<layout_type::row_major>();
+        check_broadcast_layout<layout_type::column_major>();
+    }
 }
@@ -6,8 +6,14 @@
 * The full license is in the file LICENSE, distributed with this software. *
 ****************************************************************************/
 
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "xtensor/xadapt.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xindexview.hpp"
 #include "xtensor/xnoalias.hpp"
+#include "xtensor/xview.hpp"
 #include "test_xsemantic.hpp"
 
 namespace xt
@@ -293,4 +299,51 @@ namespace xt
             EXPECT_TRUE(full_equal(tester.res_u, a));
         }
     }
+
+    TEST(scalar_semantic, contiguous)
+    {
+        std::size_t size = 2 * XTENSOR_PARALLEL_GRAIN_SIZE + 5;
+        xarray<double> a = arange<double>(double(size));
+        a += a(3);
+        EXPECT_EQ(3., a(0));
+        EXPECT_EQ(double(size + 2), a(size - 1));
+
+        xtensor<float, 1> f = arange<float>(float(size));
+        f *= 2;
+        EXPECT_EQ(2.f * float(size - 1), f(size - 1));
+        f -= 0.5;
+        EXPECT_EQ(1.5f, f(1));
+
+        xarray<int> i = arange<int>(11);
+        i /= 2;
+        EXPECT_EQ(5, i(10));
+        EXPECT_EQ(0, i(1));
+
+        std::vector<double> v(size, 1.);
+        auto ad = xadapt(v, std::vector<std::size_t>({size}));
+        ad += 2.;
+        EXPECT_EQ(3., v[0]);
+        EXPECT_EQ(3., v[size - 1]);
+    }
+
+    TEST(scalar_semantic, views)
+    {
+        xarray<double> a = arange<double>(12.);
+        a.reshape({3, 4});
+
+        auto v = view(a, all(), 1);
+        v -= 1.;
+        EXPECT_EQ(4., a(1, 1));
+        EXPECT_EQ(6., a(1, 2));
+
+        auto t = transpose(a);
+        t *= 2.;
+        EXPECT_EQ(8., a(1, 1));
+        EXPECT_EQ(22., a(2, 3));
+
+        auto f = filter(a, a > 20.);
+        f += 100.;
+        EXPECT_EQ(122., a(2, 3));
+        EXPECT_EQ(20., a(2, 2));
+    }
 }
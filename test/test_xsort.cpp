@@ -0,0 +1,169 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xsort.hpp"
+#include "xtensor/xtensor.hpp"
+
+namespace xt
+{
+    TEST(xsort, sort)
+    {
+        xarray<int> a = {{3, 1, 2}, {9, 7, 8}};
+        xarray<int> res0 = sort(a, 0);
+        xarray<int> res1 = sort(a, 1);
+        EXPECT_EQ(xarray<int>({{3, 1, 2}, {9, 7, 8}}), res0);
+        EXPECT_EQ(xarray<int>({{1, 2, 3}, {7, 8, 9}}), res1);
+
+        xarray<int> b = {{5, 1}, {2, 4}, {0, 3}};
+        EXPECT_EQ(xarray<int>({{0, 1}, {2, 3}, {5, 4}}), sort(b, 0));
+
+        xtensor<double, 1> t = {4., -1., 2.5};
+        auto st = sort(t + 1., 0);
+        EXPECT_TRUE((std::is_same<decltype(st), xtensor<double, 1>>::value));
+        xtensor<double, 1> expected = {0., 3.5, 5.};
+        EXPECT_EQ(expected, st);
+
+        EXPECT_THROW(sort(a, 2), std::out_of_range);
+    }
+
+    TEST(xsort, sort_in_place)
+    {
+        xarray<double> a = arange<double>(24);
+        a.reshape({2, 3, 4});
+        xarray<double> r = -a;
+        xarray<double, layout_type::column_major> c = r;
+        sort_in_place(r, 1);
+        sort_in_place(c, 1);
+        EXPECT_EQ(r, c);
+        EXPECT_EQ(-11., r(0, 0, 3));
+        EXPECT_EQ(-3., r(0, 2, 3));
+        EXPECT_EQ(-21., r(1, 0, 1));
+        EXPECT_EQ(-13., r(1, 2, 1));
+    }
+
+    TEST(xsort, argsort)
+    {
+        xarray<double> a = {{2., 0., 1., 0.}, {-1., 3., 3., -2.}};
+        xarray<std::size_t> res1 = argsort(a, 1);
+        EXPECT_EQ(xarray<std::size_t>({{1, 3, 2, 0}, {3, 0, 1, 2}}), res1);
+        xarray<std::size_t> res0 = argsort(a, 0);
+        EXPECT_EQ(xarray<std::size_t>({{1, 0, 0, 1}, {0, 1, 1, 0}}), res0);
+    }
+
+    TEST(xsort, partition)
+    {
+        xarray<int> a = {{7, 3, 9, 1, 5, 2}, {0, 8, 6, 4, 2, 1}};
+        xarray<int> p = partition(a, 2, 1);
+        xarray<std::size_t> ip = argpartition(a, 2, 1);
+        xarray<int> s = sort(a, 1);
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            EXPECT_EQ(s(i, 2), p(i, 2));
+            EXPECT_EQ(s(i, 2), a(i, ip(i, 2)));
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                EXPECT_EQ(j < 2, p(i, j) < s(i, 2));
+                EXPECT_EQ(j < 2, a(i, ip(i, j)) < s(i, 2));
+            }
+        }
+        EXPECT_THROW(partition(a, 6, 1), std::out_of_range);
+    }
+
+    TEST(xsort, median)
+    {
+        xarray<int> a = {{3, 1, 4, 1}, {5, 9, 2, 6}, {5, 3, 5, 8}};
+        xarray<double> m0 = median(a, 0);
+        xarray<double> m1 = median(a, 1);
+        EXPECT_EQ(xarray<double>({5., 3., 4., 6.}), m0);
+        EXPECT_EQ(xarray<double>({2., 5.5, 5.}), m1);
+        EXPECT_EQ(4.5, median(a));
+
+        xarray<double> p = percentile(a, 25., 1);
+        EXPECT_DOUBLE_EQ(1., p(0));
+        EXPECT_DOUBLE_EQ(4.25, p(1));
+        EXPECT_DOUBLE_EQ(4.5, p(2));
+        EXPECT_EQ(1., percentile(a, 0.));
+        EXPECT_EQ(9., percentile(a, 100.));
+        EXPECT_THROW(percentile(a, 101.), std::out_of_range);
+
+        xarray<double> e = xarray<double>::from_shape({2, 0});
+        xarray<double> me = median(e, 1);
+        EXPECT_EQ(2u, me.size());
+        EXPECT_TRUE(std::isnan(me(1)));
+    }
+
+    TEST(xsort, long_rows)
+    {
+        std::size_t n = 1000;
+        xtensor<double, 2> a = xtensor<double, 2>::from_shape({std::size_t(70), n});
+        for (std::size_t i = 0; i < a.shape()[0]; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                a(i, j) = double((j * 7919 + i) % n);
+            }
+        }
+        auto s = sort(a, 1);
+        auto idx = argsort(a, 1);
+        for (std::size_t i = 0; i < a.shape()[0]; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                EXPECT_EQ(double(j), s(i, j));
+                EXPECT_EQ(double(j), a(i, idx(i, j)));
+            }
+        }
+    }
+
+    TEST(xsort, topk)
+    {
+        xarray<int> a = {{3, 9, 1, 9, 4}, {0, -2, 7, 5, 7}};
+        auto t1 = topk(a, 2, 1);
+        EXPECT_EQ(xarray<int>({{9, 9}, {7, 7}}), t1.first);
+        EXPECT_EQ(xarray<std::size_t>({{1, 3}, {2, 4}}), t1.second);
+
+        auto t0 = topk(a, 1, 0);
+        EXPECT_EQ(xarray<int>({{3, 9, 7, 9, 7}}), t0.first);
+        EXPECT_EQ(xarray<std::size_t>({{0, 0, 1, 0, 1}}), t0.second);
+
+        auto all_sorted = topk(a + 0, 5, 1);
+        xarray<int> expected = sort(-a, 1);
+        EXPECT_EQ(-expected, all_sorted.first);
+
+        EXPECT_EQ(0u, topk(a, 0, 1).first.size());
+        EXPECT_THROW(topk(a, 6, 1), std::out_of_range);
+    }
+
+    TEST(xsort, topk_long_rows)
+    {
+        std::size_t n = 5000;
+        xtensor<float, 2> a = xtensor<float, 2>::from_shape({std::size_t(16), n});
+        for (std::size_t i = 0; i < a.shape()[0]; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                a(i, j) = float((j * 7919 + i * 13) % n);
+            }
+        }
+        auto t = topk(a, 8, 1);
+        EXPECT_TRUE((std::is_same<decltype(t.first), xtensor<float, 2, layout_type::row_major>>::value));
+        for (std::size_t i = 0; i < a.shape()[0]; ++i)
+        {
+            for (std::size_t j = 0; j < 8; ++j)
+            {
+                EXPECT_EQ(float(n - 1 - j), t.first(i, j));
+                EXPECT_EQ(t.first(i, j), a(i, t.second(i, j)));
+            }
+        }
+    }
+}
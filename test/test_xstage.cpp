@@ -0,0 +1,71 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xmath.hpp"
+#include "xtensor/xparallel.hpp"
+#include "xtensor/xstage.hpp"
+#include "xtensor/xstridedview.hpp"
+
+namespace xt
+{
+    TEST(xstage, access)
+    {
+        xarray<double> a = {{1., 2., 3.}, {4., 5., 6.}};
+        auto s = stage(a * 2.);
+        EXPECT_EQ(a.shape(), s.shape());
+        EXPECT_EQ(a.dimension(), s.dimension());
+        EXPECT_EQ(8., s(1, 0));
+        xindex index = {1, 2};
+        EXPECT_EQ(12., s[index]);
+    }
+
+    TEST(xstage, chunked_assign)
+    {
+        std::size_t size = 100003;
+        xarray<double> x = arange<double>(double(size));
+        xarray<double> y = ones<double>({size});
+
+        auto d = stage(x - y);
+        xarray<double> res = d / sqrt(d * d + 1.);
+        xarray<double> expected = (x - y) / sqrt((x - y) * (x - y) + 1.);
+        EXPECT_EQ(expected, res);
+
+        xarray<double> nested = stage(stage(x * 2.) + 1.) * 3.;
+        EXPECT_EQ(xarray<double>((x * 2. + 1.) * 3.), nested);
+
+        // The scratch buffers are released after the assignment
+        EXPECT_EQ(x(5) - 1., d(5));
+        res += stage(x) * 0.;
+        EXPECT_EQ(expected, res);
+    }
+
+    TEST(xstage, parallel_chunked_assign)
+    {
+        set_num_threads(4);
+        xarray<double> x = arange<double>(double((1 << 20) + 5));
+        auto d = stage(x * 2.);
+        xarray<double> res = d + stage(d + x);
+        EXPECT_EQ(xarray<double>(x * 5.), res);
+        set_num_threads(0);
+    }
+
+    TEST(xstage, non_trivial_assign)
+    {
+        xarray<double> m = arange<double>(12.);
+        m.reshape({3, 4});
+        xarray<double> row = arange<double>(4.);
+        xarray<double> res = stage(m + row) * 2.;
+        EXPECT_EQ(xarray<double>((m + row) * 2.), res);
+
+        xarray<double> res2 = stage(transpose(m)) + 1.;
+        EXPECT_EQ(xarray<double>(transpose(m) + 1.), res2);
+    }
+}
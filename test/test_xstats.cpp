@@ -0,0 +1,86 @@
+/***************************************************************************
+* Copyright (c) 2016, Johan Mabille, Sylvain Corlay and Wolf Vollprecht    *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
+#include "xtensor/xbuilder.hpp"
+#include "xtensor/xmath.hpp"
+#include "xtensor/xstats.hpp"
+
+namespace xt
+{
+    TEST(xstats, all)
+    {
+        xarray<double> a = {{2., 4., 4.}, {4., 5., 5.}, {7., 9., 0.}};
+        auto s = stats(a);
+        EXPECT_EQ(9u, s.count());
+        EXPECT_DOUBLE_EQ(40. / 9., s.mean());
+        EXPECT_DOUBLE_EQ(0., s.min());
+        EXPECT_DOUBLE_EQ(9., s.max());
+
+        double m2 = 0.;
+        for (auto v : a)
+        {
+            m2 += (v - 40. / 9.) * (v - 40. / 9.);
+        }
+        EXPECT_NEAR(m2, s.m2(), 1e-12);
+        EXPECT_NEAR(m2 / 8., s.variance(1)(), 1e-12);
+        EXPECT_TRUE(std::isnan(s.variance(9)()));
+        EXPECT_TRUE(std::isnan(s.variance(10)()));
+    }
+
+    TEST(xstats, axes)
+    {
+        xarray<double> a = arange<double>(24);
+        a.reshape({2, 3, 4});
+        xarray<double, layout_type::column_major> b = a;
+
+        auto s = stats(a, {0, 2});
+        auto sb = stats(b, {0, 2});
+        auto ss = stats(a + 0., {0, 2});
+        xarray<double> expected_mean = mean(a, {0, 2});
+        xarray<double> expected_min = {0., 4., 8.};
+        xarray<double> expected_max = {15., 19., 23.};
+        xarray<std::size_t> expected_count = {8, 8, 8};
+        for (const auto& r : {s, sb, ss})
+        {
+            EXPECT_EQ(expected_count, r.count);
+            EXPECT_TRUE(all(isclose(expected_mean, r.mean)));
+            EXPECT_EQ(expected_min, r.min);
+            EXPECT_EQ(expected_max, r.max);
+            // {4, 5, 6, 7} and {16, 17, 18, 19}, 6 apart from the mean
+            EXPECT_NEAR(2. * 5. + 8. * 36., r.m2(1), 1e-9);
+        }
+    }
+
+    TEST(xstats, stability)
+    {
+        // Large offset: the naive sum of squares loses all the digits.
+        std::size_t size = 100000;
+        xarray<double> a = xarray<double>::from_shape({size});
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            a(i) = 1e9 + double(i % 4);
+        }
+        auto s = stats(a);
+        EXPECT_NEAR(1e9 + 1.5, s.mean(), 1e-6);
+        EXPECT_NEAR(1.25, s.variance()(), 1e-6);
+    }
+
+    TEST(xstats, integral)
+    {
+        xarray<int> a = {{1, 2}, {3, 6}};
+        auto s = stats(a, {1});
+        EXPECT_EQ(xarray<double>({1.5, 4.5}), s.mean);
+        EXPECT_EQ(xarray<double>({0.5, 4.5}), s.m2);
+        EXPECT_EQ(xarray<int>({1, 3}), s.min);
+        EXPECT_EQ(xarray<int>({2, 6}), s.max);
+    }
+}
@@ -7,7 +7,10 @@
 ****************************************************************************/
 
 #include "gtest/gtest.h"
+#include "xtensor/xarray.hpp"
 #include "xtensor/xstorage.hpp"
+#include "xtensor/xtensor.hpp"
+#include <cstdint>
 #include <numeric>
 
 namespace xt
@@ -72,5 +75,70 @@ namespace xt
             EXPECT_EQ(double(i), a[i]);
         }
     }
-}
 
+    template <class T>
+    bool is_aligned(const T* p, std::size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+
+    TEST(aligned_allocator, allocate)
+    {
+        using aligned_vector = uvector<double, aligned_allocator<double, 64>>;
+        for (size_t i = 1; i < 40; ++i)
+        {
+            aligned_vector a(i, 1.5);
+            EXPECT_TRUE(is_aligned(a.data(), 64));
+            EXPECT_EQ(1.5, a[i - 1]);
+            a.resize(i * 100);
+            EXPECT_TRUE(is_aligned(a.data(), 64));
+        }
+
+        std::vector<char, aligned_allocator<char, 32>> b(7, 'a');
+        EXPECT_TRUE(is_aligned(b.data(), 32));
+        b.resize(1000, 'b');
+        EXPECT_TRUE(is_aligned(b.data(), 32));
+        EXPECT_EQ('a', b[6]);
+        EXPECT_EQ('b', b[999]);
+
+        aligned_allocator<double, 64> alloc;
+        aligned_allocator<int, 64> int_alloc(alloc);
+        EXPECT_TRUE(alloc == int_alloc);
+        EXPECT_FALSE(alloc != int_alloc);
+    }
+
+    TEST(aligned_allocator, container_alignment)
+    {
+        std::size_t aligned_alignment = container_alignment<uvector<float, aligned_allocator<float, 64>>>::value;
+        EXPECT_EQ(64u, aligned_alignment);
+        std::size_t vector_alignment = container_alignment<std::vector<float, aligned_allocator<float, 16>>>::value;
+        EXPECT_EQ(16u, vector_alignment);
+        std::size_t default_alignment = container_alignment<uvector<float>>::value;
+        EXPECT_EQ(alignof(float), default_alignment);
+
+        using array_type = xarray<double, layout_type::row_major, aligned_allocator<double, 64>>;
+        using tensor_type = xtensor<double, 2, layout_type::row_major, aligned_allocator<double, 64>>;
+        std::size_t array_alignment = array_type::data_alignment;
+        EXPECT_EQ(64u, array_alignment);
+        std::size_t tensor_alignment = tensor_type::data_alignment;
+        EXPECT_EQ(64u, tensor_alignment);
+    }
+
+    TEST(aligned_allocator, assign)
+    {
+        using array_type = xarray<double, layout_type::row_major, aligned_allocator<double, 64>>;
+        for (size_t n = 1; n < 20; ++n)
+        {
+            array_type::shape_type shape = {n, 3};
+            array_type a(shape);
+            std::iota(a.begin(), a.end(), 0.);
+            xarray<double> b = a;
+            array_type res = a + 2. * b;
+            EXPECT_TRUE(is_aligned(res.data().data(), 64));
+            for (size_t i = 0; i < res.size(); ++i)
+            {
+                EXPECT_EQ(3. * double(i), res.data()[i]);
+            }
+        }
+    }
+}
@@ -30,5 +30,28 @@ namespace xt
         auto val = vt[{1, 0, 1}];
         EXPECT_EQ(e(1, 0, 1), val);
     }
+
+    TEST(xstridedview, transpose_function_assignment)
+    {
+        xarray<double> e = xt::arange<double>(24);
+        e.reshape({2, 3, 4});
+        xarray<double> b = xt::arange<double>(2);
+
+        xarray<double> res = transpose(e) + b;
+        ASSERT_EQ(shape_t({4, 3, 2}), res.shape());
+        for (size_t i = 0; i < 4; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                for (size_t k = 0; k < 2; ++k)
+                {
+                    EXPECT_EQ(e(k, j, i) + b(k), res(i, j, k));
+                }
+            }
+        }
+
+        xarray<double> res2 = transpose(transpose(e)) * 2.;
+        EXPECT_EQ(e * 2., res2);
+    }
 }
 